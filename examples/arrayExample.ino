@@ -0,0 +1,67 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Array.h"
+
+//two sensors behind a TCA9548A multiplexer on Wire, and one sensor directly on Wire1
+SCD30Mux mux(Wire, SCD30_MUX_DEFAULT_ADDRESS);
+
+SCD30 scdSensor0(mux, 0); //channel 0 of the multiplexer
+SCD30 scdSensor1(mux, 1); //channel 1 of the multiplexer
+SCD30 scdSensor2(Wire1);
+
+SCD30 *sensors[] = { &scdSensor0, &scdSensor1, &scdSensor2 };
+SCD30Array scdArray(sensors, 3);
+
+void printValues(uint8_t index, const SCD30::Measurement &sample)
+{
+    Serial.print("sensor:");
+    Serial.print(index);
+
+    Serial.print(" co2(ppm):");
+    Serial.print(sample.co2, 0);
+
+    Serial.print(" temp(C):");
+    Serial.print(sample.temperature, 1);
+
+    Serial.print(" humidity(%):");
+    Serial.print(sample.humidity, 1);
+    Serial.println();
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdArray.begin(50000); //this will cause readings to occur every two seconds on all sensors, 50 kHz for the long cables
+    scdArray.setCallback(printValues);
+
+    //the bus is only held for the transfers, not for the read delays in between
+    Serial.print("bus time per sample(us):");
+    Serial.println(scdSensor0.getSampleBusTime());
+}
+
+void loop()  
+{
+    scdArray.update(); //checks one sensor per call, never waits for the sensor
+}
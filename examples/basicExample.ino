@@ -38,15 +38,21 @@ void setup()
 
 void loop()  
 {
-    Serial.print("co2(ppm):");
-    Serial.print(scdSensor.getCO2());
+    SCD30::Measurement sample;
 
-    Serial.print(" temp(C):");
-    Serial.print(scdSensor.getTemperatureC(), 1);
+    //one ready check and one 18 byte read per sample, all values come from the same read
+    if (scdSensor.read(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2, 0);
 
-    Serial.print(" humidity(%):");
-    Serial.print(scdSensor.getHumidity(), 1);
-    Serial.println();
+        Serial.print(" temp(C):");
+        Serial.print(sample.temperature, 1);
 
-    delay(2000); //print values every two seconds
+        Serial.print(" humidity(%):");
+        Serial.print(sample.humidity, 1);
+        Serial.println();
+    }
+
+    delay(2000); //check for new values every two seconds
 }
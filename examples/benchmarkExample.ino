@@ -0,0 +1,124 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+//measures the cost of the driver itself, without a sensor
+//the SCD30 reads synthetic frames from a SCD30MockTransport, so only decoding, CRC and the sample pipeline are timed
+//runs on any board, or on the host with the build in extras/host (make run)
+#include "SCD30_I2C_lib.h"
+#include "SCD30_MockTransport.h"
+#include "SCD30_SampleBuffer.h"
+
+#ifndef BENCHMARK_ITERATIONS
+    #define BENCHMARK_ITERATIONS 100000UL //raise to millions on the host
+#endif
+
+#define BENCHMARK_FRAMES 16
+
+uint8_t frames[BENCHMARK_FRAMES][18];
+
+SCD30MockTransport mock(frames, BENCHMARK_FRAMES);
+SCD30 scdSensor(mock);
+SCD30SampleBuffer<32> samples;
+
+volatile uint8_t sink; //keeps the compiler from dropping the work
+
+//prints the time per iteration in ns
+void printResult(const char *name, uint32_t elapsed, uint32_t iterations)
+{
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print((float)elapsed * 1000.0f / iterations, 1);
+    Serial.println(" ns");
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 benchmark");
+
+    //synthetic frames with slowly changing values
+    for (uint8_t i = 0; i < BENCHMARK_FRAMES; i++)
+        SCD30MockTransport::encodeFrame(frames[i], 400.0f + i * 12.5f, 21.0f + i * 0.1f, 40.0f + i * 0.5f);
+
+    scdSensor.begin();
+    scdSensor.attachBuffer(&samples);
+
+    uint32_t start;
+
+    //CRC of one 2 byte word
+    start = micros();
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+        sink = scdSensor.computeCRC8(&frames[i % BENCHMARK_FRAMES][(i % 6) * 3], 2);
+    printResult("computeCRC8 (word)", micros() - start, BENCHMARK_ITERATIONS);
+
+    //same without the table
+    start = micros();
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+        sink = scd30ComputeCRC8Bitwise(&frames[i % BENCHMARK_FRAMES][(i % 6) * 3], 2);
+    printResult("scd30ComputeCRC8Bitwise (word)", micros() - start, BENCHMARK_ITERATIONS);
+
+    //parse one frame, including all CRC checks, without the bus
+    uint32_t co2, temperature, humidity;
+
+    start = micros();
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+    {
+        sink = scd30ParseFrameLoop(frames[i % BENCHMARK_FRAMES], co2, temperature, humidity);
+        sink = co2 ^ temperature ^ humidity;
+    }
+    printResult("scd30ParseFrameLoop (baseline)", micros() - start, BENCHMARK_ITERATIONS);
+
+    start = micros();
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+    {
+        sink = scd30ParseFrame(frames[i % BENCHMARK_FRAMES], co2, temperature, humidity);
+        sink = co2 ^ temperature ^ humidity;
+    }
+    printResult("scd30ParseFrame", micros() - start, BENCHMARK_ITERATIONS);
+
+    //read and decode one frame, including all CRC checks
+    start = micros();
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+        sink = scdSensor.readMeasurement();
+    printResult("readMeasurement", micros() - start, BENCHMARK_ITERATIONS);
+
+    //whole pipeline: ready check, read, ring buffer and packing
+    SCD30::Measurement sample;
+    SCD30PackedSample packed;
+    uint32_t previous = 0;
+
+    start = micros();
+    for (uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+    {
+        scdSensor.read(sample);
+        packed = scd30Pack(sample, previous);
+        previous = sample.timestamp;
+        sink = packed.co2;
+    }
+    printResult("read + buffer + pack", micros() - start, BENCHMARK_ITERATIONS);
+
+    Serial.print("frames played back: ");
+    Serial.println(mock.getFramesRead());
+}
+
+void loop()  
+{
+    //nothing to do
+}
@@ -0,0 +1,77 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_SampleBuffer.h"
+
+SCD30 scdSensor;
+SCD30SampleBuffer<32> samples; //room for 32 samples, no heap allocation
+
+//gets a whole span of samples at once, e.g. to send them in one radio packet
+void sendBatch(const SCD30::Measurement batch[], uint16_t count)
+{
+    Serial.print("batch of ");
+    Serial.print(count);
+    Serial.print(" samples, missed:");
+    Serial.print(scdSensor.getMissedSamples()); //not read before the sensor had the next one
+    Serial.print(" overwritten in buffer:");
+    Serial.println(samples.getOverflows()); //not drained before the buffer was full
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        Serial.print("  seq:");
+        Serial.print(batch[i].sequence);
+
+        Serial.print(" t(ms):");
+        Serial.print(batch[i].timestamp);
+
+        Serial.print(" co2(ppm):");
+        Serial.print(batch[i].co2, 0);
+
+        Serial.print(" temp(C):");
+        Serial.print(batch[i].temperature, 1);
+
+        Serial.print(" humidity(%):");
+        Serial.print(batch[i].humidity, 1);
+        Serial.println();
+    }
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+    scdSensor.attachBuffer(&samples); //every sample read is pushed into the buffer
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+    scdSensor.read(sample);
+
+    //send the samples in batches of 8
+    if (samples.size() >= 8)
+        samples.drain(sendBatch, 8);
+
+    delay(2000); //check for new values every two seconds
+}
@@ -0,0 +1,63 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Deadband.h"
+
+SCD30 scdSensor;
+SCD30Deadband deadband(25, 0.3f, 2.0f, 600000); //25 ppm, 0.3 degC, 2 %RH or at least every 10 minutes
+
+//only called when the sample changed enough, this is where it would be sent
+void sendValues(const SCD30::Measurement &sample)
+{
+    Serial.print("co2(ppm):");
+    Serial.print(sample.co2, 0);
+
+    Serial.print(" temp(C):");
+    Serial.print(sample.temperature, 1);
+
+    Serial.print(" humidity(%):");
+    Serial.print(sample.humidity, 1);
+
+    Serial.print(" held back:");
+    Serial.print(deadband.getSuppressed());
+    Serial.println();
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+
+    deadband.setCallback(sendValues);
+    scdSensor.attachDeadband(&deadband); //every sample read goes through the filter
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    scdSensor.read(sample); //samples that did not change are dropped by the filter
+
+    delay(100);
+}
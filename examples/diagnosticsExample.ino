@@ -0,0 +1,118 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+
+//diagnostics sweep over several sensors behind a TCA9548A multiplexer
+//all settings of all sensors are read as non-blocking jobs, loop() is never stalled for more than one short transaction per sensor
+#define SENSOR_COUNT 4
+#define SWEEP_INTERVAL 60000 //ms
+
+SCD30Mux mux(Wire, SCD30_MUX_DEFAULT_ADDRESS);
+
+SCD30 sensors[SENSOR_COUNT] = { SCD30(mux, 0), SCD30(mux, 1), SCD30(mux, 2), SCD30(mux, 3) };
+SCD30Settings settings[SENSOR_COUNT];
+
+uint32_t lastSweep = 0;
+boolean sweeping = false;
+
+void printSettings(uint8_t index, const SCD30Settings &s)
+{
+    Serial.print("sensor:");
+    Serial.print(index);
+
+    Serial.print(" firmware:");
+    Serial.print(s.firmwareVersion[0]);
+    Serial.print(".");
+    Serial.print(s.firmwareVersion[1]);
+
+    Serial.print(" interval(s):");
+    Serial.print(s.measurementInterval);
+
+    Serial.print(" ASC:");
+    Serial.print(s.automaticSelfCalibration ? "on" : "off");
+
+    Serial.print(" FRC(ppm):");
+    Serial.print(s.forcedRecalibrationValue);
+
+    Serial.print(" temp offset(0.01C):");
+    Serial.print(s.temperatureOffset);
+
+    Serial.print(" altitude(m):");
+    Serial.print(s.altitude);
+    Serial.println();
+}
+
+//starts the jobs on all sensors, they are run by loop()
+void startSweep()
+{
+    lastSweep = millis();
+    sweeping = true;
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++)
+        sensors[i].startReadSettings();
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++)
+        sensors[i].begin(); //this will cause readings to occur every two seconds
+
+    //a single sensor can also be read in one blocking call
+    if (sensors[0].readAllSettings(settings[0]) == SCD30_OK)
+        printSettings(0, settings[0]);
+
+    startSweep();
+}
+
+void loop()  
+{
+    if (sweeping == false && millis() - lastSweep >= SWEEP_INTERVAL)
+        startSweep();
+
+    if (sweeping == true)
+    {
+        sweeping = false;
+
+        //every sensor gets one step per loop, the read delays of all sensors overlap
+        for (uint8_t i = 0; i < SENSOR_COUNT; i++)
+        {
+            SCD30ReadState state = sensors[i].pollSettings(settings[i]);
+
+            if (state == SCD30_READ_PENDING)
+                sweeping = true;
+            else if (state == SCD30_READ_DONE)
+                printSettings(i, settings[i]);
+            else if (state == SCD30_READ_FAILED)
+            {
+                Serial.print("sensor:");
+                Serial.print(i);
+                Serial.print(" failed: ");
+                Serial.println(scd30ErrorToString(sensors[i].getLastError()));
+            }
+        }
+    }
+
+    //... the rest of the application runs here
+}
@@ -0,0 +1,53 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_Driver.h"
+
+//integer values only, no float math is linked in, the sample is the 8 byte packed format ready for a radio payload
+SCD30Driver<SCD30WireTransport, SCD30FixedDecode> scdSensor;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(2); //this will cause readings to occur every two seconds
+}
+
+void loop()  
+{
+    SCD30PackedSample sample;
+
+    if (scdSensor.read(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2);
+
+        Serial.print(" temp(0.01C):");
+        Serial.print(sample.temperature);
+
+        Serial.print(" humidity(0.01%):");
+        Serial.print(sample.humidity);
+        Serial.println();
+    }
+
+    delay(100);
+}
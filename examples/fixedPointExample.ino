@@ -0,0 +1,68 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+//build with -DSCD30_FIXED_POINT (or uncomment it in SCD30_I2C_lib.h) to leave the float getters out of the library
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+
+SCD30 scdSensor;
+
+//prints a value given in 0.01 units, e.g. 2215 as 22.15, without float formatting
+void printCenti(int32_t centi)
+{
+    if (centi < 0)
+    {
+        Serial.print("-");
+        centi = -centi;
+    }
+
+    Serial.print(centi / 100);
+    Serial.print(".");
+    if (centi % 100 < 10) Serial.print("0");
+    Serial.print(centi % 100);
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    if (scdSensor.read(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(scdSensor.getCO2ppm());
+
+        Serial.print(" temp(C):");
+        printCenti(scdSensor.getTemperatureCentiC());
+
+        Serial.print(" humidity(%):");
+        printCenti(scdSensor.getHumidityCentiPct());
+        Serial.println();
+    }
+
+    delay(2000); //check for new values every two seconds
+}
@@ -0,0 +1,70 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Array.h"
+#include "SCD30_Group.h"
+
+//four sensors in one room behind a TCA9548A multiplexer
+SCD30Mux mux(Wire, SCD30_MUX_DEFAULT_ADDRESS);
+
+SCD30 scdSensor0(mux, 0);
+SCD30 scdSensor1(mux, 1);
+SCD30 scdSensor2(mux, 2);
+SCD30 scdSensor3(mux, 3);
+
+SCD30 *sensors[] = { &scdSensor0, &scdSensor1, &scdSensor2, &scdSensor3 };
+SCD30Array scdArray(sensors, 4);
+SCD30Group zone(scdArray, 1000); //samples of one cycle have to come in within 1 s
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdArray.begin();
+    zone.begin(2); //same 2 s interval on all sensors, restarted together
+}
+
+void loop()  
+{
+    if (zone.update() == true) //true once per group cycle, the zone values are computed only then
+    {
+        Serial.print("co2 median(ppm):");
+        Serial.print(zone.getMedian(SCD30_QUANTITY_CO2), 0);
+
+        Serial.print(" mean(ppm):");
+        Serial.print(zone.getMean(SCD30_QUANTITY_CO2), 0);
+
+        Serial.print(" temp(C):");
+        Serial.print(zone.getMean(SCD30_QUANTITY_TEMPERATURE), 1);
+
+        Serial.print(" humidity(%):");
+        Serial.print(zone.getMean(SCD30_QUANTITY_HUMIDITY), 1);
+
+        Serial.print(" sensors:");
+        Serial.print(zone.getZone().sensors);
+
+        Serial.print(" outliers:");
+        Serial.print(zone.getOutliers(), HEX);
+        Serial.println();
+    }
+}
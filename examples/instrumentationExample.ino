@@ -0,0 +1,59 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+
+#define REPORT_INTERVAL 60000 //ms
+
+SCD30 scdSensor;
+SCD30DriverStats driverStats = {}; //filled by the driver, see SCD30_Instrumentation.h
+uint32_t lastReport = 0;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.attachInstrumentation(&driverStats); //begin() is timed as well
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    scdSensor.read(sample); //checks the ready status every 250 ms, most checks find no new sample
+
+    if (millis() - lastReport >= REPORT_INTERVAL)
+    {
+        lastReport = millis();
+
+        scdSensor.printStats(Serial);
+
+        //the stats can also be read directly
+        Serial.print("slowest measurement read(us): ");
+        Serial.println(driverStats.operations[SCD30_OPERATION_MEASUREMENT].maxTime);
+
+        scdSensor.resetStats();
+    }
+
+    delay(250);
+}
@@ -23,16 +23,17 @@ https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.
 
 SCD30 scdSensor;
 
-void printValues()
+//called from service() in loop(), not from the interrupt, so it is safe to use Serial and I2C here
+void printValues(const SCD30::Measurement &sample)
 {
     Serial.print("co2(ppm):");
-    Serial.print(scdSensor.getCO2());
+    Serial.print(sample.co2, 0);
 
     Serial.print(" temp(C):");
-    Serial.print(scdSensor.getTemperatureC(), 1);
+    Serial.print(sample.temperature, 1);
 
     Serial.print(" humidity(%):");
-    Serial.print(scdSensor.getHumidity(), 1);
+    Serial.print(sample.humidity, 1);
     Serial.println();
 }
 
@@ -49,10 +50,11 @@ void setup()
     scdSensor.setAmbientPressure(1020); //set pressure in mBar
 
     //the RDY pin of SCD30 is connected to the A5 analog pin on the MCU (Adafruit Metro M4 in my case)
-    scdSensor.attachExternalInterrupt(PIN_A5, printValues);
+    //the interrupt only flags the new sample, it is read by service()
+    scdSensor.attachReadyInterrupt(PIN_A5, printValues);
 }
 
 void loop()  
 {
-    //empty loop
+    scdSensor.service(); //reads the sample once RDY went high and calls printValues
 }
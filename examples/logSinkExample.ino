@@ -0,0 +1,81 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include <SPI.h>
+#include <SD.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_SampleBuffer.h"
+#include "SCD30_LogSink.h"
+
+#define SD_CS_PIN 10
+#define FLUSH_PERIOD 3600000UL //a partial block is written at least once per hour
+
+SCD30 scdSensor;
+SCD30SampleBuffer<16> samples; //every sample read by the sensor ends up here
+File logFile;
+
+//appends one 512 byte block, the file only ever grows by whole blocks, so they stay aligned to the sectors of the card
+boolean writeBlock(const uint8_t block[], uint32_t /*blockNumber*/)
+{
+    if (logFile.write(block, SCD30_LOG_BLOCK_SIZE) != SCD30_LOG_BLOCK_SIZE)
+        return false;
+
+    logFile.flush();
+    return true;
+}
+
+SCD30LogSink logSink(writeBlock);
+uint32_t lastFlush = 0;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    if (SD.begin(SD_CS_PIN) == false)
+        Serial.println("no SD card");
+
+    logFile = SD.open("SCD30.LOG", FILE_WRITE); //appends to the log of earlier runs, decode it with extras/scd30_log_decode.py
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+    scdSensor.attachBuffer(&samples);
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+    scdSensor.read(sample); //pushed into the buffer, no formatting or writing per sample
+
+    logSink.drain(samples); //one write per 62 samples
+
+    if (millis() - lastFlush >= FLUSH_PERIOD)
+    {
+        logSink.flush();
+        lastFlush = millis();
+
+        Serial.print("blocks:");
+        Serial.print(logSink.getBlocks());
+        Serial.print(" write errors:");
+        Serial.println(logSink.getWriteErrors());
+    }
+
+    delay(100);
+}
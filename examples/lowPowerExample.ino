@@ -0,0 +1,75 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+
+#define USE_RDY_PIN 1 //0 wakes the MCU by the measurement interval, RDY does not have to be connected then
+#define USE_POWER_DOWN 0 //1 uses power-down on AVR instead of idle, it defines the watchdog and pin change interrupts
+
+#if USE_POWER_DOWN
+    #include "SCD30_PowerDown.h"
+#endif
+
+SCD30 scdSensor;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+    scdSensor.setMeasurementInterval(10); //we want to change the measurement interval that to 10 seconds
+
+#if USE_RDY_PIN
+    //the RDY pin of SCD30 is connected to the A5 analog pin on the MCU, no callback is needed
+    scdSensor.attachReadyInterrupt(PIN_A5, NULL);
+    scdSensor.setWakeSource(SCD30_WAKE_READY);
+#else
+    scdSensor.setWakeSource(SCD30_WAKE_TIMER);
+#endif
+
+#if USE_POWER_DOWN
+    scdSensor.setSleepHook(scd30SleepPowerDown);
+#else
+    scdSensor.setSleepHook(scd30Sleep); //idle or light sleep, without a hook sleepUntilReady() only waits
+#endif
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    //the MCU sleeps until the sample is ready
+    if (scdSensor.sleepUntilReady(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2, 0);
+
+        Serial.print(" temp(C):");
+        Serial.print(sample.temperature, 1);
+
+        Serial.print(" humidity(%):");
+        Serial.print(sample.humidity, 1);
+        Serial.println();
+
+        Serial.flush(); //let the UART finish before sleeping again
+    }
+}
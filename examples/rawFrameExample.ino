@@ -0,0 +1,58 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Frame.h"
+
+SCD30 scdSensor;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+}
+
+void loop()  
+{
+    uint8_t frame[SCD30_FRAME_SIZE];
+
+    if (scdSensor.dataAvailable() == true && scdSensor.readRawFrame(frame) == SCD30_OK)
+    {
+        //forward the frame as it is, the CRCs were checked, the decoding is left to the receiver
+        Serial.print("frame:");
+        for (uint8_t i = 0; i < SCD30_FRAME_SIZE; i++)
+        {
+            if (frame[i] < 0x10)
+                Serial.print("0");
+            Serial.print(frame[i], HEX);
+        }
+
+        //only the CO2 field is decoded, temperature and humidity are never parsed
+        SCD30Frame decoded(frame);
+        Serial.print(" co2(ppm):");
+        Serial.print(decoded.getCO2ppm());
+        Serial.println();
+    }
+
+    delay(100);
+}
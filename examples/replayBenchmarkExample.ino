@@ -0,0 +1,284 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+//replays a recorded trace with the faults seen on a real bus and checks and times every stage of the driver
+//the trace are the frames as printed by rawFrameExample, the faults are injected by the SCD30MockTransport
+//every loop() is one round of REPLAY_PASSES passes over the trace, once through the current parser and once through the baseline
+//(the byte switch parser with the bitwise CRC it replaced), the totals are printed after every round, so it can run as a soak test
+//runs on any board, or on the host with the build in extras/host (make replay)
+#include "SCD30_I2C_lib.h"
+#include "SCD30_MockTransport.h"
+#include "SCD30_SampleBuffer.h"
+#include "SCD30_Stats.h"
+#include "SCD30_Frame.h"
+
+#ifndef REPLAY_PASSES
+    #define REPLAY_PASSES 100 //passes over the trace per round
+#endif
+
+#define TRACE_FRAMES 16
+
+//CO2 rising in an occupied room, with a single spike
+const uint8_t trace[TRACE_FRAMES][18] = {
+    { 0x44, 0x19, 0x40, 0x19, 0x9A, 0xCE, 0x41, 0xB3, 0x10, 0x47, 0xAE, 0x45, 0x42, 0x24, 0x93, 0xCC, 0xCD, 0x94 }, //612.4 ppm
+    { 0x44, 0x1A, 0x13, 0xB9, 0x9A, 0x31, 0x41, 0xB3, 0x10, 0x70, 0xA4, 0x82, 0x42, 0x25, 0xA2, 0x33, 0x33, 0x88 }, //618.9 ppm
+    { 0x44, 0x1C, 0xB5, 0x46, 0x66, 0x4F, 0x41, 0xB3, 0x10, 0x85, 0x1F, 0xB8, 0x42, 0x26, 0xF1, 0x00, 0x00, 0x81 }, //625.1 ppm
+    { 0x44, 0x1E, 0xD7, 0x73, 0x33, 0x01, 0x41, 0xB3, 0x10, 0xAE, 0x14, 0x94, 0x42, 0x26, 0xF1, 0x66, 0x66, 0x93 }, //633.8 ppm
+    { 0x44, 0x20, 0x0D, 0x4C, 0xCD, 0xB7, 0x41, 0xB3, 0x10, 0xC2, 0x8F, 0xA6, 0x42, 0x27, 0xC0, 0x99, 0x9A, 0xED }, //641.2 ppm
+    { 0x44, 0x22, 0x6F, 0xAC, 0xCD, 0xC1, 0x41, 0xB4, 0x87, 0x14, 0x7B, 0x7E, 0x42, 0x28, 0xEE, 0x00, 0x00, 0x81 }, //650.7 ppm
+    { 0x44, 0x24, 0xC9, 0x53, 0x33, 0xDD, 0x41, 0xB4, 0x87, 0x28, 0xF6, 0x4E, 0x42, 0x28, 0xEE, 0xCC, 0xCD, 0x94 }, //657.3 ppm
+    { 0x44, 0x27, 0x9A, 0x00, 0x00, 0x81, 0x41, 0xB4, 0x87, 0x66, 0x66, 0x93, 0x42, 0x29, 0xDF, 0x33, 0x33, 0x88 }, //668.0 ppm
+    { 0x44, 0x28, 0xB4, 0xE6, 0x66, 0xB0, 0x41, 0xB4, 0x87, 0x8F, 0x5C, 0x38, 0x42, 0x2A, 0x8C, 0x00, 0x00, 0x81 }, //675.6 ppm
+    { 0x44, 0x2A, 0xD6, 0xCC, 0xCD, 0x94, 0x41, 0xB4, 0x87, 0xA3, 0xD7, 0xC0, 0x42, 0x2A, 0x8C, 0x66, 0x66, 0x93 }, //683.2 ppm
+    { 0x44, 0x2C, 0x70, 0xB9, 0x9A, 0x31, 0x41, 0xB4, 0x87, 0xE1, 0x48, 0x87, 0x42, 0x2B, 0xBD, 0x33, 0x33, 0x88 }, //690.9 ppm
+    { 0x44, 0x2E, 0x12, 0x59, 0x9A, 0x47, 0x41, 0xB4, 0x87, 0xF5, 0xC3, 0xFA, 0x42, 0x2B, 0xBD, 0x99, 0x9A, 0xED }, //697.4 ppm
+    { 0x44, 0xE7, 0xDD, 0x46, 0x66, 0x4F, 0x41, 0xB5, 0xB6, 0x0A, 0x3D, 0xE6, 0x42, 0x2C, 0x2A, 0x00, 0x00, 0x81 }, //1850.2 ppm
+    { 0x44, 0x32, 0x2C, 0x33, 0x33, 0x88, 0x41, 0xB5, 0xB6, 0x47, 0xAE, 0x45, 0x42, 0x2C, 0x2A, 0x66, 0x66, 0x93 }, //712.8 ppm
+    { 0x44, 0x33, 0x1D, 0xE0, 0x00, 0xF7, 0x41, 0xB5, 0xB6, 0x5C, 0x29, 0xDC, 0x42, 0x2D, 0x1B, 0x33, 0x33, 0x88 }, //719.5 ppm
+    { 0x44, 0x35, 0xBB, 0x46, 0x66, 0x4F, 0x41, 0xB5, 0xB6, 0x85, 0x1F, 0xB8, 0x42, 0x2D, 0x1B, 0x99, 0x9A, 0xED }, //725.1 ppm
+};
+
+//faults seen next to the trace, sorted by frame
+const SCD30MockFault faults[] = {
+    { 3, SCD30_MOCK_FAULT_STRETCH, 150 },
+    { 5, SCD30_MOCK_FAULT_CRC, 0 },
+    { 9, SCD30_MOCK_FAULT_NACK, 0 },
+    { 12, SCD30_MOCK_FAULT_STRETCH, 900 },
+    { 14, SCD30_MOCK_FAULT_CRC, 0 },
+};
+
+#define FAULT_COUNT (sizeof(faults) / sizeof(faults[0]))
+#define CRC_FAULTS 2 //frames lost per pass, the NACKed frame is read again
+
+SCD30MockTransport mock(trace, TRACE_FRAMES);
+SCD30 scdSensor(mock);
+SCD30Stats stats;
+SCD30SampleBuffer<32> samples;
+
+//time spent in one stage, in us
+struct Stage
+{
+    uint64_t total; //32 bits would wrap after 71 minutes of a soak test
+    uint32_t maximum;
+};
+
+//totals of one parser over all rounds
+struct Run
+{
+    Stage read; //bus transfer, CRC checks and decoding
+    Stage stats;
+    Stage buffer;
+    uint32_t frames; //frames decoded
+    uint32_t failures; //reads that failed
+    uint32_t checksum; //of the decoded bit patterns, the same for both parsers
+};
+
+Run current;
+Run baseline;
+uint32_t rounds = 0;
+
+void addTime(Stage &stage, uint32_t elapsed)
+{
+    stage.total += elapsed;
+    if (elapsed > stage.maximum)
+        stage.maximum = elapsed;
+}
+
+uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//the read measurement transaction the way it was done before: byte switch parser with the bitwise CRC
+boolean readBaseline(SCD30::Measurement &sample)
+{
+    uint8_t frame[SCD30_FRAME_SIZE];
+    uint32_t co2, temperature, humidity;
+
+    if (mock.writeCommand(SCD30_READ_MEASUREMENT) != SCD30_OK || mock.read(frame, sizeof(frame)) != SCD30_OK)
+        return false;
+
+    if (scd30ParseFrameLoop(frame, co2, temperature, humidity) == false)
+        return false;
+
+    memcpy(&sample.co2, &co2, sizeof(co2));
+    memcpy(&sample.temperature, &temperature, sizeof(temperature));
+    memcpy(&sample.humidity, &humidity, sizeof(humidity));
+    sample.timestamp = millis();
+    return true;
+}
+
+//one pass over the trace per REPLAY_PASSES, every stage timed on its own
+void replay(Run &run, boolean useBaseline)
+{
+    SCD30::Measurement sample;
+    uint32_t reads = TRACE_FRAMES + 1; //the NACKed frame takes one more read
+
+    mock.rewind();
+
+    for (uint16_t pass = 0; pass < REPLAY_PASSES; pass++)
+    {
+        for (uint32_t i = 0; i < reads; i++)
+        {
+            uint32_t start = micros();
+            boolean success;
+
+            if (useBaseline == true)
+                success = readBaseline(sample);
+            else
+            {
+                success = scdSensor.readMeasurement();
+                sample = scdSensor.getMeasurement();
+            }
+
+            addTime(run.read, micros() - start);
+
+            if (success == false)
+            {
+                run.failures++;
+                continue;
+            }
+
+            run.frames++;
+            run.checksum += floatBits(sample.co2) ^ floatBits(sample.temperature) ^ floatBits(sample.humidity);
+
+            start = micros();
+            stats.add(sample);
+            addTime(run.stats, micros() - start);
+
+            start = micros();
+            samples.push(sample);
+            addTime(run.buffer, micros() - start);
+        }
+    }
+}
+
+void printStage(const char *name, const Stage &stage, uint32_t frames)
+{
+    Serial.print("  ");
+    Serial.print(name);
+    Serial.print(" avg(us):");
+    Serial.print(frames > 0 ? (float)stage.total / frames : 0.0f, 2);
+    Serial.print(" max(us):");
+    Serial.println(stage.maximum);
+}
+
+void printRun(const char *name, const Run &run)
+{
+    uint64_t total = run.read.total + run.stats.total + run.buffer.total;
+
+    Serial.print(name);
+    Serial.print(" frames:");
+    Serial.print(run.frames);
+    Serial.print(" failures:");
+    Serial.print(run.failures);
+    Serial.print(" frames/s:");
+    Serial.println(total > 0 ? (float)run.frames * 1000000.0f / total : 0.0f, 0);
+
+    printStage("read  ", run.read, run.frames + run.failures);
+    printStage("stats ", run.stats, run.frames);
+    printStage("buffer", run.buffer, run.frames);
+}
+
+#if defined(__AVR__)
+extern char __heap_start;
+extern char *__brkval;
+
+//fills the free RAM between heap and stack with a pattern, what is overwritten later was used by the stack
+void paintStack()
+{
+    char here;
+    char *p = (__brkval != NULL) ? __brkval : &__heap_start;
+
+    while (p < &here - 32)
+        *p++ = 0xA5;
+}
+
+//returns bytes of stack used at most since paintStack()
+uint16_t stackPeak()
+{
+    char *p = (__brkval != NULL) ? __brkval : &__heap_start;
+
+    while (p <= (char*)RAMEND && *p == (char)0xA5)
+        p++;
+
+    return (char*)RAMEND - p + 1;
+}
+#endif
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 replay benchmark");
+
+#if defined(__AVR__)
+    paintStack();
+#endif
+
+    scdSensor.begin();
+    mock.setFaults(faults, FAULT_COUNT);
+
+    //static RAM of the pipeline
+    Serial.print("RAM(bytes) sensor:");
+    Serial.print(sizeof(scdSensor));
+    Serial.print(" transport:");
+    Serial.print(sizeof(mock));
+    Serial.print(" stats:");
+    Serial.print(sizeof(stats));
+    Serial.print(" buffer:");
+    Serial.print(sizeof(samples));
+    Serial.print(" trace:");
+    Serial.println(sizeof(trace));
+}
+
+void loop()  
+{
+    replay(current, false);
+    replay(baseline, true);
+    rounds++;
+
+    Serial.print("round:");
+    Serial.print(rounds);
+    Serial.print(" crc faults:");
+    Serial.print(mock.getFaults(SCD30_MOCK_FAULT_CRC));
+    Serial.print(" nacks:");
+    Serial.print(mock.getFaults(SCD30_MOCK_FAULT_NACK));
+    Serial.print(" stretches:");
+    Serial.println(mock.getFaults(SCD30_MOCK_FAULT_STRETCH));
+
+    printRun("current", current);
+    printRun("baseline", baseline);
+
+    //every pass has to lose exactly the frames with a CRC fault, and both parsers have to decode the same values
+    uint32_t expected = rounds * (uint32_t)REPLAY_PASSES * (TRACE_FRAMES - CRC_FAULTS);
+    boolean pass = current.frames == expected && baseline.frames == expected && current.checksum == baseline.checksum;
+
+    Serial.print("check:");
+    Serial.println(pass ? "PASS" : "FAIL");
+
+#if defined(__AVR__)
+    Serial.print("stack peak(bytes):");
+    Serial.println(stackPeak());
+#endif
+
+    Serial.println();
+}
@@ -0,0 +1,75 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+//ESP32 only, or another FreeRTOS port with SCD30_FREERTOS defined for the whole build
+//a task on core 0 owns the sensor, loop() on core 1 only picks up the latest sample and never waits for the bus
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_RTOS.h"
+
+SCD30 scdSensor;
+SemaphoreHandle_t busMutex; //every driver on Wire takes it before it uses the bus
+SCD30SensorTask *sensorTask;
+
+uint32_t lastSequence = 0;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    busMutex = xSemaphoreCreateMutex();
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+
+    static SCD30SensorTask task(scdSensor, busMutex);
+    sensorTask = &task;
+    sensorTask->start(SCD30_TASK_STACK, SCD30_TASK_PRIORITY, 0); //from now on only the task uses scdSensor
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    //cheap check, no lock and no bus access
+    if (sensorTask->getSequence() != lastSequence && sensorTask->getLatest(sample) == true)
+    {
+        lastSequence = sensorTask->getSequence();
+
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2, 0);
+
+        Serial.print(" temp(C):");
+        Serial.print(sample.temperature, 1);
+
+        Serial.print(" humidity(%):");
+        Serial.print(sample.humidity, 1);
+        Serial.println();
+    }
+
+    //other drivers on the same bus
+    if (xSemaphoreTake(busMutex, portMAX_DELAY) == pdTRUE)
+    {
+        //... use Wire here
+        xSemaphoreGive(busMutex);
+    }
+
+    delay(100);
+}
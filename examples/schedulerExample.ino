@@ -0,0 +1,64 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Scheduler.h"
+
+SCD30 scdSensor;
+SCD30Scheduler scheduler(scdSensor);
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+    scdSensor.setMeasurementInterval(10); //we want to change the measurement interval that to 10 seconds
+
+    scheduler.begin(); //learns the real period between samples, starting from the 10 s interval
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    //only touches the bus shortly before the next sample is due
+    if (scheduler.update(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2, 0);
+
+        Serial.print(" temp(C):");
+        Serial.print(sample.temperature, 1);
+
+        Serial.print(" humidity(%):");
+        Serial.print(sample.humidity, 1);
+
+        Serial.print(" period(ms):");
+        Serial.print(scheduler.getPeriod());
+
+        Serial.print(" ready checks:");
+        Serial.print(scheduler.getPolls());
+        Serial.println();
+    }
+
+    delay(scheduler.timeUntilNextPoll()); //or put the MCU to sleep for that long
+}
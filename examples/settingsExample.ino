@@ -44,10 +44,16 @@ void setup()
     scdSensor.stopMeasuring();
     scdSensor.softReset();
 
-    delay(15000);
-    
-    scdSensor.begin();
-    //we wait a while for the sensor to reset itself and read the values again
+    //instead of waiting a fixed time, the settings are applied as soon as the sensor answers again
+    //only the settings that differ from what the sensor has are written
+    SCD30Config config;
+    config.measurementInterval = 2;
+    config.altitude = 240; //m
+    config.ambientPressure = 1020; //mBar
+
+    scdSensor.applyConfig(config);
+    scdSensor.waitForData(5000); //wait for the first sample, at most 5 s
+
     Serial.print("Set measurement interval: ");
     Serial.println(scdSensor.getMeasurementInterval());
     Serial.print("FRC value: ");
@@ -56,16 +62,21 @@ void setup()
 
 void loop()  
 {
+    SCD30::Measurement sample;
+
     //it will take some time for the sensor to recalibrate itself
-    Serial.print("co2(ppm):");
-    Serial.print(scdSensor.getCO2());
+    if (scdSensor.read(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2, 0);
 
-    Serial.print(" temp(C):");
-    Serial.print(scdSensor.getTemperatureC(), 1);
+        Serial.print(" temp(C):");
+        Serial.print(sample.temperature, 1);
 
-    Serial.print(" humidity(%):");
-    Serial.print(scdSensor.getHumidity(), 1);
-    Serial.println();
+        Serial.print(" humidity(%):");
+        Serial.print(sample.humidity, 1);
+        Serial.println();
+    }
 
-    delay(2000); //print values every two seconds
-}
\ No newline at end of file
+    delay(2000); //check for new values every two seconds
+}
@@ -0,0 +1,93 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Stats.h"
+
+#define SHORT_WINDOW 60000UL //1 minute
+#define LONG_WINDOW 900000UL //15 minutes
+
+SCD30 scdSensor;
+SCD30Stats shortStats(0.2f); //EWMA follows quickly
+SCD30Stats longStats(0.05f);
+
+void printAggregate(const char *name, SCD30Stats &stats)
+{
+    SCD30RunningStats &co2 = stats.getCO2();
+
+    Serial.print(name);
+    Serial.print(" samples:");
+    Serial.print(stats.getCount());
+
+    Serial.print(" co2 mean:");
+    Serial.print(co2.getMean(), 0);
+    Serial.print(" sd:");
+    Serial.print(co2.getStdDev(), 1);
+    Serial.print(" min:");
+    Serial.print(co2.getMin(), 0);
+    Serial.print(" max:");
+    Serial.print(co2.getMax(), 0);
+    Serial.print(" ewma:");
+    Serial.print(co2.getEWMA(), 0);
+    Serial.print(" slope(ppm/min):");
+    Serial.print(co2.getSlope(), 1);
+
+    Serial.print(" temp mean(C):");
+    Serial.print(stats.getTemperature().getMean(), 1);
+    Serial.print(" humidity mean(%):");
+    Serial.print(stats.getHumidity().getMean(), 1);
+    Serial.println();
+}
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    scdSensor.begin(); //this will cause readings to occur every two seconds
+
+    scdSensor.attachStats(&shortStats); //every sample read is added
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    if (scdSensor.read(sample) == true)
+    {
+        longStats.add(sample); //a second window is fed by hand
+
+        //send the aggregates instead of every sample
+        if (shortStats.getDuration() >= SHORT_WINDOW)
+        {
+            printAggregate("1min", shortStats);
+            shortStats.reset();
+        }
+
+        if (longStats.getDuration() >= LONG_WINDOW)
+        {
+            printAggregate("15min", longStats);
+            longStats.reset();
+        }
+    }
+
+    delay(100);
+}
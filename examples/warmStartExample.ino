@@ -0,0 +1,63 @@
+/*
+Written by Nejc Klemenčič, December 19th, 2019
+
+This is a library for the SCD30 CO2 Sensor Module. 
+The sensor uses either I2C or UART to comminucate.
+This library is intented for the I2C interface.
+
+The library with the UART interface can be found at: https://github.com/NejcKle/sens2
+
+The SCD30 measures CO2 with an accuracy of +/- 30ppm.
+
+This library handles the initialization of the SCD30
+and outputs CO2, humidity and temperature levels.
+
+It also implements the option to read data with an interrupt connected to the SCD30's RDY pin.
+
+Sensor interface description can be found at: 
+https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.5_CO2/Sensirion_CO2_Sensors_SCD30_Interface_Description.pdf.
+*/
+
+#include <Wire.h>
+#include "SCD30_I2C_lib.h"
+
+SCD30 scdSensor;
+
+void setup()  
+{
+    Serial.begin(9600);
+    Serial.println("SCD30 Example");
+
+    SCD30Config config;
+    config.measurementInterval = 5; //s
+    config.altitude = 240; //m
+
+    //after a reset of the MCU only (e.g. by the watchdog) the sensor is still measuring with this config,
+    //nothing is written then and the measurement cycle is not restarted
+    //on a cold sensor, or one with other settings, the config is applied as usual
+    scdSensor.begin(config, SCD30_WARM_START);
+
+    Serial.print("Measurement interval: ");
+    Serial.println(scdSensor.getMeasurementInterval()); //read back by begin(), answered from the cache
+}
+
+void loop()  
+{
+    SCD30::Measurement sample;
+
+    //the first read after a warm start usually gets a sample right away
+    if (scdSensor.read(sample) == true)
+    {
+        Serial.print("co2(ppm):");
+        Serial.print(sample.co2, 0);
+
+        Serial.print(" temp(C):");
+        Serial.print(sample.temperature, 1);
+
+        Serial.print(" humidity(%):");
+        Serial.print(sample.humidity, 1);
+        Serial.println();
+    }
+
+    delay(500);
+}
@@ -0,0 +1,96 @@
+/*
+Minimal stand-in for the Arduino core, just enough to build the library and the benchmark sketches on a PC.
+Time is taken from the steady clock of the host, Serial prints to stdout, every pin reads high
+and only SDA and SCL do something, see Wire.h.
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define DEC 10
+#define HEX 16
+#define SDA 18
+#define SCL 19
+#define digitalPinToInterrupt(pin) (pin)
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+class Print
+{
+    public:
+        virtual ~Print() {}
+        virtual size_t write(uint8_t c) { return fwrite(&c, 1, 1, stdout); }
+        size_t write(const uint8_t *data, size_t length) { return fwrite(data, 1, length, stdout); }
+
+        size_t print(const char *text) { return printf("%s", text); }
+        size_t print(char c) { return printf("%c", c); }
+        size_t print(int value, int base = DEC) { return printf(base == HEX ? "%X" : "%d", value); }
+        size_t print(unsigned int value, int base = DEC) { return printf(base == HEX ? "%X" : "%u", value); }
+        size_t print(long value, int base = DEC) { return printf(base == HEX ? "%lX" : "%ld", value); }
+        size_t print(unsigned long value, int base = DEC) { return printf(base == HEX ? "%lX" : "%lu", value); }
+        size_t print(double value, int digits = 2) { return printf("%.*f", digits, value); }
+
+        size_t println() { return printf("\n"); }
+        template <class T> size_t println(T value) { size_t n = print(value); return n + println(); }
+        template <class T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+class Stream : public Print
+{
+    public:
+        virtual int available() { return 0; }
+        virtual int read() { return -1; }
+        void flush() { fflush(stdout); }
+
+        size_t readBytes(uint8_t *buffer, size_t length)
+        {
+            size_t i = 0;
+            for (; i < length; i++)
+            {
+                int c = read();
+                if (c < 0)
+                    break;
+                buffer[i] = c;
+            }
+            return i;
+        }
+};
+
+class HardwareSerial : public Stream
+{
+    public:
+        void begin(unsigned long) {}
+        operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
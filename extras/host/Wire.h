@@ -0,0 +1,78 @@
+/*
+Minimal stand-in for the Wire library, there is no bus on the host.
+By default every transaction is not acknowledged, the benchmarks use SCD30MockTransport instead.
+Set ackAddress to have a device that acknowledges and sends zeros, as recoverTest does.
+
+It keeps the state the way the ESP32 core does: begin() on a started bus does nothing, and pinMode()
+on SDA or SCL takes the pin away from the I2C peripheral until end() and begin() attach it again.
+A started bus that lost its pins fails every transaction.
+*/
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include "Arduino.h"
+
+class TwoWire : public Stream
+{
+    public:
+        void begin()
+        {
+            if (started == true)
+                return; //the ESP32 core only logs that the bus is already started
+
+            started = true;
+            attached = true;
+        }
+
+        void end()
+        {
+            started = false;
+            attached = false;
+        }
+
+        void detachPins() { attached = false; } //called by pinMode() on SDA or SCL
+        boolean isWorking() { return started == true && attached == true; }
+
+        void setClock(uint32_t) {}
+        void beginTransmission(uint8_t address) { this->address = address; }
+        size_t write(uint8_t) { return 1; }
+
+        uint8_t endTransmission(bool = true)
+        {
+            if (isWorking() == false)
+                return 4; //other error
+
+            return (ackAddress != 0 && address == ackAddress) ? 0 : 2; //2: address not acknowledged
+        }
+
+        uint8_t requestFrom(uint8_t address, uint8_t length)
+        {
+            pending = (isWorking() == true && ackAddress != 0 && address == ackAddress) ? length : 0;
+            return pending;
+        }
+
+        int available() { return pending; }
+
+        int read()
+        {
+            if (pending == 0)
+                return -1;
+
+            pending--;
+            return 0;
+        }
+
+        uint8_t ackAddress = 0; //0: no device on the bus
+
+    private:
+        boolean started = false;
+        boolean attached = false;
+        uint8_t address = 0;
+        uint8_t pending = 0; //bytes left of the last requestFrom()
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
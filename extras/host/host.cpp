@@ -0,0 +1,62 @@
+/*
+Runs a sketch on the host: the Arduino functions of Arduino.h, and main() calling setup() and loop().
+loop() runs HOST_LOOPS times (environment variable, default 1).
+*/
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include <chrono>
+#include <thread>
+#include <stdlib.h>
+
+HardwareSerial Serial;
+TwoWire Wire;
+TwoWire Wire1;
+
+static uint64_t elapsedMicros()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+unsigned long millis() { return (uint32_t)(elapsedMicros() / 1000); }
+unsigned long micros() { return (uint32_t)elapsedMicros(); }
+void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+void delayMicroseconds(unsigned int us)
+{
+    uint64_t end = elapsedMicros() + us;
+    while (elapsedMicros() < end)
+        ; //busy wait like the core does, sleeping is far too coarse for us
+}
+
+//a GPIO mode on SDA or SCL takes the pin away from the bus, the way the pin matrix of the ESP32 does
+void pinMode(uint8_t pin, uint8_t)
+{
+    if (pin == SDA || pin == SCL)
+        Wire.detachPins();
+}
+
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; } //every pin is pulled up, nothing holds SDA low
+void attachInterrupt(uint8_t, void (*)(void), int) {}
+void detachInterrupt(uint8_t) {}
+void noInterrupts() {}
+void interrupts() {}
+
+void setup();
+void loop();
+
+int main()
+{
+    const char *loops = getenv("HOST_LOOPS");
+    long count = (loops != NULL) ? atol(loops) : 1;
+
+    setup();
+    for (long i = 0; i < count; i++)
+        loop();
+
+    fflush(stdout);
+    return 0;
+}
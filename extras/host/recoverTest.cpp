@@ -0,0 +1,56 @@
+/*
+Checks on the host that SCD30WireTransport still talks to the sensor after recover().
+
+recover() drives SDA and SCL as GPIOs, on the ESP32 that detaches them from the I2C peripheral and
+begin() on a started bus does nothing, so the bus has to be ended first. Wire.h behaves the same way.
+Exits with 1 if a check failed, see make test.
+*/
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "SCD30_Transport.h"
+
+#include <stdlib.h>
+
+#define READY_STATUS 0x0202 //any command does, see SCD30_I2C_lib.h
+
+static int failures = 0;
+
+static void check(const char *what, boolean passed)
+{
+    Serial.print(passed ? "ok   " : "FAIL ");
+    Serial.println(what);
+
+    if (passed == false)
+        failures++;
+}
+
+//one command and its response, like a ready check
+static boolean transaction(SCD30WireTransport &transport)
+{
+    uint8_t data[3];
+
+    return transport.writeCommand(READY_STATUS) == SCD30_OK && transport.read(data, sizeof(data)) == SCD30_OK;
+}
+
+void setup()
+{
+    Wire.ackAddress = SCD30_I2C_ADDRESS;
+
+    SCD30WireTransport transport(Wire);
+    transport.begin();
+
+    check("transaction before recover()", transaction(transport));
+    check("recover() releases SDA", transport.recover());
+    check("bus attached after recover()", Wire.isWorking());
+    check("transaction after recover()", transaction(transport));
+    check("second recover()", transport.recover() && transaction(transport));
+
+    Serial.println(failures == 0 ? "PASS" : "FAIL");
+    fflush(stdout);
+    exit(failures == 0 ? 0 : 1);
+}
+
+void loop()
+{
+}
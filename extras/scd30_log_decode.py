@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""
+Decodes a binary log written by SCD30LogSink into CSV.
+
+usage: scd30_log_decode.py LOGFILE [> samples.csv]
+
+Every 512 byte block is checked for its magic, version and CRC-8, blocks that fail are
+reported on stderr and skipped. The block layout is described in src/SCD30_LogSink.h.
+"""
+
+import struct
+import sys
+
+BLOCK_SIZE = 512
+HEADER_SIZE = 16
+SAMPLE_SIZE = 8
+MAGIC = b"SCD3"
+VERSION = 1
+
+
+def crc8(data, crc=0xFF):
+    #polynomial 0x31, initialized with 0xFF, no final XOR, the same CRC the sensor uses
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x31) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def decode_block(block):
+    #returns (block number, list of (millis, co2, temperature, humidity)), raises ValueError on a bad block
+    if block[0:4] != MAGIC:
+        raise ValueError("no log block")
+
+    version, count, crc, tick = struct.unpack_from("<BBBB", block, 4)
+    if version != VERSION:
+        raise ValueError("version %d not supported" % version)
+
+    if crc8(block[0:6] + b"\x00" + block[7:]) != crc:
+        raise ValueError("CRC does not match")
+
+    if count > (BLOCK_SIZE - HEADER_SIZE) // SAMPLE_SIZE:
+        raise ValueError("%d samples do not fit into a block" % count)
+
+    number, time = struct.unpack_from("<II", block, 8)
+    samples = []
+
+    for i in range(count):
+        co2, temperature, humidity, delta = struct.unpack_from("<HhHH", block, HEADER_SIZE + i * SAMPLE_SIZE)
+        time = (time + delta * tick) & 0xFFFFFFFF
+        samples.append((time, co2, temperature / 100.0, humidity / 100.0))
+
+    return number, samples
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__.strip())
+
+    with open(sys.argv[1], "rb") as log:
+        data = log.read()
+
+    print("block,millis,co2_ppm,temperature_c,humidity_pct")
+    expected = None
+
+    for offset in range(0, len(data) - BLOCK_SIZE + 1, BLOCK_SIZE):
+        try:
+            number, samples = decode_block(data[offset:offset + BLOCK_SIZE])
+        except ValueError as error:
+            sys.stderr.write("block at offset %d skipped: %s\n" % (offset, error))
+            continue
+
+        if expected is not None and number != expected:
+            sys.stderr.write("block %d follows block %d, blocks are missing\n" % (number, expected - 1))
+        expected = number + 1
+
+        for time, co2, temperature, humidity in samples:
+            print("%d,%d,%d,%.2f,%.2f" % (number, time, co2, temperature, humidity))
+
+    if len(data) % BLOCK_SIZE != 0:
+        sys.stderr.write("%d bytes at the end are not a whole block\n" % (len(data) % BLOCK_SIZE))
+
+
+if __name__ == "__main__":
+    main()
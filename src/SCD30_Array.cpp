@@ -0,0 +1,107 @@
+/*
+Manager for several SCD30 sensors, on one or more buses and behind I2C multiplexers.
+See SCD30_Array.h for details.
+*/
+
+#include "SCD30_Array.h"
+
+SCD30Array::SCD30Array(SCD30 *sensors[], uint8_t count) : sensors(sensors), count(count)
+{
+    //constructor
+}
+
+//initializes all sensors
+//returns true if all sensors responded, the ones that did not are still polled by update()
+boolean SCD30Array::begin(uint32_t clockSpeed)
+{
+    boolean success = true;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (sensors[i]->begin(clockSpeed) == false)
+            success = false;
+    }
+
+    return success;
+}
+
+void SCD30Array::setCallback(SCD30ArrayCallback callback)
+{
+    this->callback = callback;
+}
+
+//does one round robin step, call it from loop() as often as possible
+//either finishes the read or the ready check in progress, or starts the ready check of the current sensor
+//returns the index of the sensor whose sample was read in this step, -1 otherwise
+int8_t SCD30Array::update()
+{
+    if (count == 0)
+        return -1;
+
+    SCD30 *sensor = sensors[current];
+
+    if (pending == true)
+    {
+        SCD30ReadState state = sensor->poll();
+
+        if (state == SCD30_READ_PENDING)
+            return -1; //read delay has not passed yet
+
+        uint8_t index = current;
+        pending = false;
+        advance();
+
+        if (state != SCD30_READ_DONE)
+            return -1;
+
+        if (callback != NULL)
+            callback(index, sensor->getMeasurement());
+
+        return index;
+    }
+
+    if (checking == true)
+    {
+        SCD30ReadState state = sensor->pollReady();
+
+        if (state == SCD30_READ_PENDING)
+            return -1; //read delay has not passed yet
+
+        checking = false;
+
+        if (state == SCD30_READ_DONE && sensor->startRead() == true)
+        {
+            pending = true; //stay on this sensor until the read is finished
+            return -1;
+        }
+
+        advance();
+        return -1;
+    }
+
+    if (sensor->startReadyCheck() == true)
+    {
+        checking = true;
+        return -1;
+    }
+
+    advance();
+    return -1;
+}
+
+uint8_t SCD30Array::getCount()
+{
+    return count;
+}
+
+SCD30& SCD30Array::getSensor(uint8_t index)
+{
+    return *sensors[index];
+}
+
+void SCD30Array::advance()
+{
+    current++;
+    if (current >= count)
+        current = 0;
+}
@@ -0,0 +1,44 @@
+/*
+Manager for several SCD30 sensors, on one or more buses and behind I2C multiplexers.
+
+update() does one step of a round robin over all sensors: it sends the ready check of one sensor,
+or finishes the ready check or the read of the sensor that is in progress. Ready checks use
+startReadyCheck()/pollReady() and reads startRead()/poll(), so a single step never waits for the
+read delay of the sensor, a step that is too early just returns.
+
+To keep multiplexer switching to a minimum, list sensors behind the same multiplexer next to each other.
+*/
+
+#ifndef SCD30_Array_h
+#define SCD30_Array_h
+
+#include "SCD30_I2C_lib.h"
+
+typedef void (*SCD30ArrayCallback)(uint8_t index, const SCD30Measurement &measurement); //called by update() with every new sample
+
+class SCD30Array
+{
+    public:
+        SCD30Array(SCD30 *sensors[], uint8_t count); //constructor, the array of sensors has to outlive the manager
+
+        boolean begin(uint32_t clockSpeed = SCD30_I2C_MAX_CLOCK); //initializes all sensors, returns true if all of them responded, clockSpeed is passed to every sensor
+
+        void setCallback(SCD30ArrayCallback callback); //sets the function called with every new sample
+
+        int8_t update(); //does one round robin step, returns the index of the sensor that delivered a sample or -1
+
+        uint8_t getCount(); //gets number of sensors
+        SCD30& getSensor(uint8_t index); //gets sensor at index
+
+    private:
+        void advance(); //moves on to the next sensor
+
+        SCD30 **sensors;
+        uint8_t count;
+        uint8_t current = 0; //sensor the round robin is at
+        boolean checking = false; //a ready check of the current sensor is in progress
+        boolean pending = false; //a read of the current sensor is in progress
+        SCD30ArrayCallback callback = NULL;
+};
+
+#endif
@@ -0,0 +1,132 @@
+/*
+CRC-8 used by the SCD30 on every 16 bit word it sends and receives.
+See SCD30_CRC.h for details.
+*/
+
+#include "SCD30_CRC.h"
+
+#if defined(__AVR__)
+    #include <avr/pgmspace.h>
+    #define SCD30_CRC_TABLE_READ(address) pgm_read_byte(address)
+#else
+    #ifndef PROGMEM
+        #define PROGMEM
+    #endif
+    #define SCD30_CRC_TABLE_READ(address) (*(address))
+#endif
+
+#ifndef SCD30_CRC_NIBBLE_TABLE
+
+//crc of every possible byte, table[i] = crc of i shifted through all 8 bits
+static constexpr uint8_t crcTable[256] PROGMEM = {
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E,
+    0x43, 0x72, 0x21, 0x10, 0x87, 0xB6, 0xE5, 0xD4, 0xFA, 0xCB, 0x98, 0xA9, 0x3E, 0x0F, 0x5C, 0x6D,
+    0x86, 0xB7, 0xE4, 0xD5, 0x42, 0x73, 0x20, 0x11, 0x3F, 0x0E, 0x5D, 0x6C, 0xFB, 0xCA, 0x99, 0xA8,
+    0xC5, 0xF4, 0xA7, 0x96, 0x01, 0x30, 0x63, 0x52, 0x7C, 0x4D, 0x1E, 0x2F, 0xB8, 0x89, 0xDA, 0xEB,
+    0x3D, 0x0C, 0x5F, 0x6E, 0xF9, 0xC8, 0x9B, 0xAA, 0x84, 0xB5, 0xE6, 0xD7, 0x40, 0x71, 0x22, 0x13,
+    0x7E, 0x4F, 0x1C, 0x2D, 0xBA, 0x8B, 0xD8, 0xE9, 0xC7, 0xF6, 0xA5, 0x94, 0x03, 0x32, 0x61, 0x50,
+    0xBB, 0x8A, 0xD9, 0xE8, 0x7F, 0x4E, 0x1D, 0x2C, 0x02, 0x33, 0x60, 0x51, 0xC6, 0xF7, 0xA4, 0x95,
+    0xF8, 0xC9, 0x9A, 0xAB, 0x3C, 0x0D, 0x5E, 0x6F, 0x41, 0x70, 0x23, 0x12, 0x85, 0xB4, 0xE7, 0xD6,
+    0x7A, 0x4B, 0x18, 0x29, 0xBE, 0x8F, 0xDC, 0xED, 0xC3, 0xF2, 0xA1, 0x90, 0x07, 0x36, 0x65, 0x54,
+    0x39, 0x08, 0x5B, 0x6A, 0xFD, 0xCC, 0x9F, 0xAE, 0x80, 0xB1, 0xE2, 0xD3, 0x44, 0x75, 0x26, 0x17,
+    0xFC, 0xCD, 0x9E, 0xAF, 0x38, 0x09, 0x5A, 0x6B, 0x45, 0x74, 0x27, 0x16, 0x81, 0xB0, 0xE3, 0xD2,
+    0xBF, 0x8E, 0xDD, 0xEC, 0x7B, 0x4A, 0x19, 0x28, 0x06, 0x37, 0x64, 0x55, 0xC2, 0xF3, 0xA0, 0x91,
+    0x47, 0x76, 0x25, 0x14, 0x83, 0xB2, 0xE1, 0xD0, 0xFE, 0xCF, 0x9C, 0xAD, 0x3A, 0x0B, 0x58, 0x69,
+    0x04, 0x35, 0x66, 0x57, 0xC0, 0xF1, 0xA2, 0x93, 0xBD, 0x8C, 0xDF, 0xEE, 0x79, 0x48, 0x1B, 0x2A,
+    0xC1, 0xF0, 0xA3, 0x92, 0x05, 0x34, 0x67, 0x56, 0x78, 0x49, 0x1A, 0x2B, 0xBC, 0x8D, 0xDE, 0xEF,
+    0x82, 0xB3, 0xE0, 0xD1, 0x46, 0x77, 0x24, 0x15, 0x3B, 0x0A, 0x59, 0x68, 0xFF, 0xCE, 0x9D, 0xAC
+};
+
+//checks the whole table against the compile time crc
+constexpr bool crcTableMatches(uint16_t i)
+{
+    return (i == 256) || (crcTable[i] == scd30CRC8Shift(i, 8) && crcTableMatches(i + 1));
+}
+
+static_assert(crcTableMatches(0), "CRC-8 table does not match the polynomial");
+
+uint8_t scd30ComputeCRC8(const uint8_t data[], uint8_t len)
+{
+    uint8_t crc = SCD30_CRC8_INIT;
+
+    for (uint8_t x = 0; x < len; x++)
+    {
+        crc = SCD30_CRC_TABLE_READ(&crcTable[crc ^ data[x]]); //one lookup per byte
+    }
+
+    return crc;
+}
+
+uint8_t scd30UpdateCRC8(uint8_t crc, const uint8_t data[], uint16_t len)
+{
+    for (uint16_t x = 0; x < len; x++)
+    {
+        crc = SCD30_CRC_TABLE_READ(&crcTable[crc ^ data[x]]);
+    }
+
+    return crc;
+}
+
+#else
+
+//crc of every possible high nibble, table[i] = crc of i << 4 shifted through 4 bits
+static constexpr uint8_t crcTable[16] PROGMEM = {
+    0x00, 0x31, 0x62, 0x53, 0xC4, 0xF5, 0xA6, 0x97, 0xB9, 0x88, 0xDB, 0xEA, 0x7D, 0x4C, 0x1F, 0x2E
+};
+
+constexpr bool crcTableMatches(uint8_t i)
+{
+    return (i == 16) || (crcTable[i] == scd30CRC8Shift(i << 4, 4) && crcTableMatches(i + 1));
+}
+
+static_assert(crcTableMatches(0), "CRC-8 nibble table does not match the polynomial");
+
+uint8_t scd30ComputeCRC8(const uint8_t data[], uint8_t len)
+{
+    uint8_t crc = SCD30_CRC8_INIT;
+
+    for (uint8_t x = 0; x < len; x++)
+    {
+        crc ^= data[x];
+        crc = (uint8_t)(crc << 4) ^ SCD30_CRC_TABLE_READ(&crcTable[crc >> 4]); //high nibble
+        crc = (uint8_t)(crc << 4) ^ SCD30_CRC_TABLE_READ(&crcTable[crc >> 4]); //low nibble
+    }
+
+    return crc;
+}
+
+uint8_t scd30UpdateCRC8(uint8_t crc, const uint8_t data[], uint16_t len)
+{
+    for (uint16_t x = 0; x < len; x++)
+    {
+        crc ^= data[x];
+        crc = (uint8_t)(crc << 4) ^ SCD30_CRC_TABLE_READ(&crcTable[crc >> 4]);
+        crc = (uint8_t)(crc << 4) ^ SCD30_CRC_TABLE_READ(&crcTable[crc >> 4]);
+    }
+
+    return crc;
+}
+
+#endif
+
+//bit by bit, as the checksum was calculated before the tables, kept as a baseline for benchmarks
+uint8_t scd30ComputeCRC8Bitwise(const uint8_t data[], uint8_t len)
+{
+    uint8_t crc = SCD30_CRC8_INIT;
+
+    for (uint8_t x = 0; x < len; x++)
+    {
+        crc ^= data[x]; //XOR-in the next input byte
+
+        //crc on one byte data
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            if ((crc & 0x80) != 0)
+                crc = (uint8_t)((crc << 1) ^ SCD30_CRC8_POLYNOMIAL);
+            else
+                crc <<= 1; //most significant bit is not 1, shift left
+        }
+    }
+
+    return crc;
+}
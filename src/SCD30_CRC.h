@@ -0,0 +1,43 @@
+/*
+CRC-8 used by the SCD30 on every 16 bit word it sends and receives.
+
+Polynomial is x^8+x^5+x^4+1 = 0x31, initialized with 0xFF, no final XOR.
+See 1.1.3 in the interface description document.
+
+The checksum is table driven, the 256 entry table is kept in flash (PROGMEM on AVR).
+On flash constrained parts define SCD30_CRC_NIBBLE_TABLE to use a 16 entry table instead,
+which costs two lookups per byte.
+*/
+
+#ifndef SCD30_CRC_h
+#define SCD30_CRC_h
+
+#include <stdint.h>
+
+#define SCD30_CRC8_POLYNOMIAL 0x31
+#define SCD30_CRC8_INIT 0xFF
+
+//compile time CRC, used to check the lookup tables and to precompute CRCs of constant arguments
+constexpr uint8_t scd30CRC8Shift(uint8_t crc, uint8_t bits)
+{
+    return (bits == 0) ? crc : scd30CRC8Shift((crc & 0x80) ? (uint8_t)((crc << 1) ^ SCD30_CRC8_POLYNOMIAL) : (uint8_t)(crc << 1), bits - 1);
+}
+
+constexpr uint8_t scd30CRC8Word(uint16_t word)
+{
+    return scd30CRC8Shift(scd30CRC8Shift(SCD30_CRC8_INIT ^ (word >> 8), 8) ^ (word & 0xFF), 8);
+}
+
+static_assert(scd30CRC8Word(0xBEEF) == 0x92, "CRC-8 does not match the example from the interface description");
+
+uint8_t scd30ComputeCRC8(const uint8_t data[], uint8_t len); //calculates crc checksum on len bytes
+uint8_t scd30ComputeCRC8Bitwise(const uint8_t data[], uint8_t len); //same without a table, only used as a baseline
+uint8_t scd30UpdateCRC8(uint8_t crc, const uint8_t data[], uint16_t len); //continues crc over len more bytes, for data longer than 255 bytes start with SCD30_CRC8_INIT
+
+//returns true if the two bytes at word are followed by their correct crc
+inline bool scd30CheckCRC8(const uint8_t word[])
+{
+    return scd30ComputeCRC8(word, 2) == word[2];
+}
+
+#endif
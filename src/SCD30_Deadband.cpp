@@ -0,0 +1,85 @@
+/*
+Report on change filter for SCD30 samples.
+See SCD30_Deadband.h for details.
+*/
+
+#include "SCD30_Deadband.h"
+
+SCD30Deadband::SCD30Deadband(float co2, float temperature, float humidity, uint32_t maxSilence) : co2Threshold(co2), temperatureThreshold(temperature), humidityThreshold(humidity), maxSilence(maxSilence)
+{
+    //constructor
+}
+
+//passes the sample on if a quantity moved past its threshold or the max silence time is over
+//the first sample after reset() is always passed on
+boolean SCD30Deadband::update(const SCD30Measurement &sample)
+{
+    boolean changed = (hasLast == false);
+
+    if (changed == false)
+        changed = exceeds(sample.co2, last.co2, co2Threshold) || exceeds(sample.temperature, last.temperature, temperatureThreshold) || exceeds(sample.humidity, last.humidity, humidityThreshold);
+
+    if (changed == false && maxSilence > 0)
+        changed = (sample.timestamp - last.timestamp >= maxSilence);
+
+    if (changed == false)
+    {
+        suppressed++;
+        return false;
+    }
+
+    last = sample;
+    hasLast = true;
+    passed++;
+
+    if (callback != NULL)
+        callback(sample);
+
+    return true;
+}
+
+boolean SCD30Deadband::exceeds(float value, float reference, float threshold)
+{
+    if (threshold <= 0)
+        return false;
+
+    float difference = value - reference;
+    return (difference >= threshold || difference <= -threshold);
+}
+
+void SCD30Deadband::setThresholds(float co2, float temperature, float humidity)
+{
+    co2Threshold = co2;
+    temperatureThreshold = temperature;
+    humidityThreshold = humidity;
+}
+
+void SCD30Deadband::setMaxSilence(uint32_t maxSilence)
+{
+    this->maxSilence = maxSilence;
+}
+
+void SCD30Deadband::setCallback(SCD30MeasurementCallback callback)
+{
+    this->callback = callback;
+}
+
+void SCD30Deadband::reset()
+{
+    hasLast = false;
+}
+
+const SCD30Measurement& SCD30Deadband::getLast()
+{
+    return last;
+}
+
+uint32_t SCD30Deadband::getPassed()
+{
+    return passed;
+}
+
+uint32_t SCD30Deadband::getSuppressed()
+{
+    return suppressed;
+}
@@ -0,0 +1,54 @@
+/*
+Report on change filter for SCD30 samples.
+
+A sample is passed on only if CO2, temperature or humidity moved at least the threshold away from the
+last sample that was passed on, or if nothing was passed on for the max silence time.
+Comparing against the last passed on sample, and not the previous one, lets slow drifts through as well.
+
+Attach it with SCD30::attachDeadband() and it sees every sample read by the sensor, the callback is called
+with every sample that is passed on. It can also be fed by hand with update().
+*/
+
+#ifndef SCD30_Deadband_h
+#define SCD30_Deadband_h
+
+#include "SCD30_I2C_lib.h"
+
+#define SCD30_DEADBAND_CO2 20 //ppm
+#define SCD30_DEADBAND_TEMPERATURE 0.2f //degC
+#define SCD30_DEADBAND_HUMIDITY 1.0f //%RH
+#define SCD30_DEADBAND_MAX_SILENCE 900000 //ms, a sample is passed on at least every 15 minutes
+
+class SCD30Deadband
+{
+    public:
+        SCD30Deadband(float co2 = SCD30_DEADBAND_CO2, float temperature = SCD30_DEADBAND_TEMPERATURE, float humidity = SCD30_DEADBAND_HUMIDITY, uint32_t maxSilence = SCD30_DEADBAND_MAX_SILENCE); //constructor
+
+        boolean update(const SCD30Measurement &sample); //returns true and calls the callback if sample has to be passed on
+
+        void setThresholds(float co2, float temperature, float humidity); //0 ignores changes of that quantity
+        void setMaxSilence(uint32_t maxSilence); //sets ms after which a sample is passed on anyway, 0 disables it
+        void setCallback(SCD30MeasurementCallback callback); //called with every sample that is passed on
+        void reset(); //the next sample is passed on
+
+        const SCD30Measurement& getLast(); //gets the last sample that was passed on
+        uint32_t getPassed(); //gets number of samples passed on
+        uint32_t getSuppressed(); //gets number of samples held back
+
+    private:
+        boolean exceeds(float value, float reference, float threshold);
+
+        float co2Threshold;
+        float temperatureThreshold;
+        float humidityThreshold;
+        uint32_t maxSilence;
+        SCD30MeasurementCallback callback = NULL;
+
+        SCD30Measurement last = {};
+        boolean hasLast = false;
+
+        uint32_t passed = 0;
+        uint32_t suppressed = 0;
+};
+
+#endif
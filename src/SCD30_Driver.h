@@ -0,0 +1,181 @@
+/*
+Compile-time configured SCD30 driver for boards where every byte of flash counts.
+
+SCD30Driver<Transport, Decode, Stats, Buffer> only has the hot path: start and stop the measurements,
+set the interval, check for data and read it. What it does with a sample is chosen by its policies:
+    Transport   the bus, e.g. SCD30WireTransport or SCD30MockTransport, kept by value so its
+                functions are called directly instead of through the vtable
+    Decode      SCD30FloatDecode gives a SCD30Measurement, SCD30FixedDecode an 8 byte SCD30PackedSample
+                without any float math
+    Stats       SCD30NoStats, or e.g. SCD30Stats, gets every sample through add()
+    Buffer      SCD30NoBuffer, or e.g. SCD30SampleBuffer<N>, gets every sample through push()
+The no-policies are empty and inline, the driver derives from them privately so they take no memory
+and their calls compile to nothing. Member functions of a template are only compiled when they are used.
+
+The full SCD30 class stays what it is, a template of it would break every sketch that passes a bus,
+a multiplexer or a transport to its constructor, so SCD30Driver is the slim alternative next to it:
+    SCD30Driver<> sensor; //Wire, floats, nothing attached, what SCD30 does by default on the read path
+*/
+
+#ifndef SCD30_Driver_h
+#define SCD30_Driver_h
+
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Frame.h"
+#include "SCD30_Packed.h"
+
+//decodes to SCD30Measurement, sequence counts the samples read
+struct SCD30FloatDecode
+{
+    typedef SCD30Measurement Sample;
+
+    static void decode(uint32_t co2, uint32_t temperature, uint32_t humidity, uint32_t now, uint32_t /*previous*/, Sample &sample)
+    {
+        memcpy(&sample.co2, &co2, sizeof(co2));
+        memcpy(&sample.temperature, &temperature, sizeof(temperature));
+        memcpy(&sample.humidity, &humidity, sizeof(humidity));
+        sample.timestamp = now;
+        sample.sequence++;
+    }
+};
+
+//decodes to SCD30PackedSample with integer operations only, delta is the time since the previous sample
+struct SCD30FixedDecode
+{
+    typedef SCD30PackedSample Sample;
+
+    static void decode(uint32_t co2, uint32_t temperature, uint32_t humidity, uint32_t now, uint32_t previous, Sample &sample)
+    {
+        sample = scd30PackRaw(co2, temperature, humidity, now - previous);
+    }
+};
+
+struct SCD30NoStats
+{
+    template <class Sample>
+    void add(const Sample &) {}
+};
+
+struct SCD30NoBuffer
+{
+    template <class Sample>
+    boolean push(const Sample &) { return true; }
+};
+
+template <class Transport = SCD30WireTransport, class Decode = SCD30FloatDecode, class Stats = SCD30NoStats, class Buffer = SCD30NoBuffer>
+class SCD30Driver : private Stats, private Buffer
+{
+    public:
+        typedef typename Decode::Sample Sample;
+
+        explicit SCD30Driver(const Transport &transport = Transport()) : transport(transport)
+        {
+            //constructor
+        }
+
+        //starts continuous measurements with interval s between samples
+        //returns false if the sensor did not ACK
+        boolean begin(uint16_t interval = 2)
+        {
+            transport.begin();
+
+            if (transport.writeCommand(SCD30_SET_MEASUREMENT_INTERVAL, interval) != SCD30_OK)
+                return false;
+
+            return beginMeasuring();
+        }
+
+        //see 1.4.1 in document, 0 deactivates pressure compensation
+        boolean beginMeasuring(uint16_t ambientPressure = 0)
+        {
+            return transport.writeCommand(SCD30_START_CONTINUOUS_MEASUREMENT, ambientPressure) == SCD30_OK;
+        }
+
+        //see 1.4.2 in document
+        boolean stopMeasuring()
+        {
+            return transport.writeCommand(SCD30_STOP_CONTINUOUS_MEASUREMENT) == SCD30_OK;
+        }
+
+        //see 1.4.3 in document
+        boolean setMeasurementInterval(uint16_t interval)
+        {
+            return transport.writeCommand(SCD30_SET_MEASUREMENT_INTERVAL, interval) == SCD30_OK;
+        }
+
+        //see 1.4.4 in document
+        boolean dataAvailable()
+        {
+            return checkReady() == SCD30_OK;
+        }
+
+        //checks if data is available and reads it, the sample then also goes to Stats and Buffer
+        //see 1.4.4 in document
+        boolean read(Sample &sample)
+        {
+            return tryRead(sample) == SCD30_OK;
+        }
+
+        //same as read(), but tells why no sample was read
+        SCD30Error tryRead(Sample &sample)
+        {
+            SCD30Error error = checkReady();
+            if (error != SCD30_OK)
+                return error;
+
+            uint8_t frame[SCD30_FRAME_SIZE];
+            error = transfer(SCD30_READ_MEASUREMENT, frame, sizeof(frame));
+            if (error != SCD30_OK)
+                return error;
+
+            uint32_t co2, temperature, humidity;
+            if (scd30ParseFrame(frame, co2, temperature, humidity) == false)
+                return SCD30_ERROR_CRC;
+
+            uint32_t now = millis();
+            Decode::decode(co2, temperature, humidity, now, previous, latest);
+            previous = now;
+
+            getStats().add(latest);
+            getBuffer().push(latest);
+
+            sample = latest;
+            return SCD30_OK;
+        }
+
+        const Sample& getLatest() { return latest; } //gets the latest sample
+        Stats& getStats() { return *static_cast<Stats*>(this); }
+        Buffer& getBuffer() { return *static_cast<Buffer*>(this); }
+        Transport& getTransport() { return transport; }
+
+    private:
+        //writes command and reads length bytes of response after the read delay
+        SCD30Error transfer(uint16_t command, uint8_t data[], uint8_t length)
+        {
+            SCD30Error error = transport.writeCommand(command);
+            if (error != SCD30_OK)
+                return error;
+
+            delayMicroseconds(transport.getReadDelay());
+            return transport.read(data, length);
+        }
+
+        SCD30Error checkReady()
+        {
+            uint8_t data[3];
+            SCD30Error error = transfer(SCD30_GET_READY_STATUS, data, sizeof(data));
+            if (error != SCD30_OK)
+                return error;
+
+            if (scd30CheckCRC8(data) == false)
+                return SCD30_ERROR_CRC;
+
+            return (data[0] == 0 && data[1] == 1) ? SCD30_OK : SCD30_ERROR_NOT_READY;
+        }
+
+        Transport transport;
+        Sample latest = {};
+        uint32_t previous = 0; //millis() of the previous sample
+};
+
+#endif
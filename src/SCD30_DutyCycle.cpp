@@ -0,0 +1,132 @@
+/*
+Duty cycled measurements for the SCD30.
+See SCD30_DutyCycle.h for details.
+*/
+
+#include "SCD30_DutyCycle.h"
+
+SCD30DutyCycle::SCD30DutyCycle(SCD30 &sensor, uint32_t period, uint8_t warmupSamples) : sensor(&sensor), period(period), warmupSamples(warmupSamples)
+{
+    //constructor
+}
+
+//sets the interval used while the sensor is on and stops it, call after sensor.begin()
+//returns false if the sensor did not ACK
+boolean SCD30DutyCycle::begin()
+{
+    sensor->setMeasurementInterval(SCD30_DUTY_INTERVAL);
+
+    state = SCD30_DUTY_OFF;
+    started = false;
+
+    return sensor->stopMeasuring();
+}
+
+//starts the sensor once per period, discards the warm up samples, passes the next one on and stops the sensor
+//returns true and fills measurement once per period
+boolean SCD30DutyCycle::update(SCD30Measurement &measurement)
+{
+    uint32_t now = millis();
+
+    if (state == SCD30_DUTY_OFF)
+    {
+        if (started == true && now - cycleStart < period)
+            return false;
+
+        cycleStart = (started == true) ? cycleStart + period : now; //keeps the cycles on a fixed grid
+        if (now - cycleStart >= period)
+            cycleStart = now; //we fell behind by more than a period, start a new grid
+
+        started = true;
+        discarded = 0;
+
+        if (sensor->resumeMeasuring() == false) //keeps the ambient pressure the user set
+        {
+            failures++;
+            return false; //tried again next period
+        }
+
+        state = SCD30_DUTY_WARMING;
+        measureStart = now;
+        lastCheck = now;
+        return false;
+    }
+
+    if (now - measureStart > (uint32_t)(warmupSamples + SCD30_DUTY_TIMEOUT_CYCLES) * SCD30_DUTY_INTERVAL * 1000)
+    {
+        stop(false); //the sensor did not deliver, do not leave it running
+        return false;
+    }
+
+    if (now - lastCheck < SCD30_DUTY_POLL_SPACING)
+        return false;
+
+    lastCheck = now;
+
+    SCD30Measurement sample;
+    if (sensor->read(sample) == false)
+        return false;
+
+    if (discarded < warmupSamples)
+    {
+        discarded++;
+        return false;
+    }
+
+    measurement = sample;
+    stop(true);
+    return true;
+}
+
+void SCD30DutyCycle::stop(boolean success)
+{
+    sensor->stopMeasuring();
+    state = SCD30_DUTY_OFF;
+
+    if (success == true)
+        cycles++;
+    else
+        failures++;
+}
+
+void SCD30DutyCycle::setPeriod(uint32_t period)
+{
+    this->period = period;
+}
+
+void SCD30DutyCycle::setWarmupSamples(uint8_t warmupSamples)
+{
+    this->warmupSamples = warmupSamples;
+}
+
+//returns ms until update() will do something, the MCU can sleep that long
+uint32_t SCD30DutyCycle::timeUntilNextCheck()
+{
+    uint32_t now = millis();
+
+    if (state == SCD30_DUTY_OFF)
+    {
+        if (started == false || now - cycleStart >= period)
+            return 0;
+
+        return period - (now - cycleStart);
+    }
+
+    uint32_t sinceCheck = now - lastCheck;
+    return (sinceCheck < SCD30_DUTY_POLL_SPACING) ? SCD30_DUTY_POLL_SPACING - sinceCheck : 0;
+}
+
+SCD30DutyState SCD30DutyCycle::getState()
+{
+    return state;
+}
+
+uint32_t SCD30DutyCycle::getCycles()
+{
+    return cycles;
+}
+
+uint32_t SCD30DutyCycle::getFailures()
+{
+    return failures;
+}
@@ -0,0 +1,63 @@
+/*
+Duty cycled measurements for the SCD30.
+
+Instead of measuring continuously, the sensor is started once per period, the first samples after the start
+are discarded while the sensor warms up, the next sample is passed on and the sensor is stopped again.
+For nodes that report e.g. once an hour this saves most of the sensor current and of the bus traffic.
+
+Call update() from loop(), one call waits at most for the read delays of one ready check and one read, a few ms.
+timeUntilNextCheck() tells how long the MCU can sleep.
+The sensor is restarted with the ambient pressure set last, see SCD30::resumeMeasuring().
+*/
+
+#ifndef SCD30_DutyCycle_h
+#define SCD30_DutyCycle_h
+
+#include "SCD30_I2C_lib.h"
+
+#define SCD30_DUTY_INTERVAL 2 //s between samples while the sensor is on
+#define SCD30_DUTY_WARMUP 3 //samples discarded after every start
+#define SCD30_DUTY_POLL_SPACING 100 //ms between ready checks while the sensor is on
+#define SCD30_DUTY_TIMEOUT_CYCLES 3 //the sensor is stopped if the sample is this many intervals late
+
+enum SCD30DutyState
+{
+    SCD30_DUTY_OFF, //sensor is stopped until the next period
+    SCD30_DUTY_WARMING //sensor is measuring, the warm up samples are discarded
+};
+
+class SCD30DutyCycle
+{
+    public:
+        SCD30DutyCycle(SCD30 &sensor, uint32_t period, uint8_t warmupSamples = SCD30_DUTY_WARMUP); //constructor, period in ms between samples passed on
+
+        boolean begin(); //stops the sensor, the first cycle starts right away
+        boolean update(SCD30Measurement &measurement); //runs the cycle, returns true with the stable sample once per period
+
+        void setPeriod(uint32_t period); //sets ms from the start of one cycle to the start of the next
+        void setWarmupSamples(uint8_t warmupSamples); //sets number of samples discarded after every start
+
+        uint32_t timeUntilNextCheck(); //gets ms until update() has something to do
+        SCD30DutyState getState();
+        uint32_t getCycles(); //gets number of stable samples passed on
+        uint32_t getFailures(); //gets number of cycles without a stable sample
+
+    private:
+        void stop(boolean success); //stops the sensor and waits for the next period
+
+        SCD30 *sensor;
+        uint32_t period;
+        uint8_t warmupSamples;
+
+        SCD30DutyState state = SCD30_DUTY_OFF;
+        uint32_t cycleStart = 0; //millis() the current cycle is due at, on the grid of the period
+        uint32_t measureStart = 0; //millis() the measurements were started, the timeout counts from here
+        uint32_t lastCheck = 0; //millis() of the last ready check
+        boolean started = false; //false until the first cycle was started
+        uint8_t discarded = 0; //warm up samples discarded in this cycle
+
+        uint32_t cycles = 0;
+        uint32_t failures = 0;
+};
+
+#endif
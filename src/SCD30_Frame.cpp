@@ -0,0 +1,182 @@
+/*
+Raw measurement frame of the SCD30 and a lazy decoder for it.
+See SCD30_Frame.h for details.
+*/
+
+#include <string.h>
+
+#include "SCD30_Frame.h"
+#include "SCD30_CRC.h"
+#include "SCD30_Packed.h"
+
+//every 2 data bytes are followed by their CRC, see 1.1.3 in document
+bool scd30CheckFrame(const uint8_t frame[])
+{
+    for (uint8_t w = 0; w < SCD30_FRAME_SIZE; w += 3)
+    {
+        if (scd30CheckCRC8(&frame[w]) == false)
+            return false;
+    }
+
+    return true;
+}
+
+//every field is assembled from its fixed offsets right after its two CRC bytes were checked,
+//no loop and no branch per byte
+//returns false on the first CRC mismatch, the outputs are only complete if true is returned
+bool scd30ParseFrame(const uint8_t frame[], uint32_t &co2, uint32_t &temperature, uint32_t &humidity)
+{
+    if (scd30CheckCRC8(&frame[0]) == false || scd30CheckCRC8(&frame[3]) == false)
+        return false;
+    co2 = scd30FrameField(frame, SCD30_FRAME_CO2);
+
+    if (scd30CheckCRC8(&frame[6]) == false || scd30CheckCRC8(&frame[9]) == false)
+        return false;
+    temperature = scd30FrameField(frame, SCD30_FRAME_TEMPERATURE);
+
+    if (scd30CheckCRC8(&frame[12]) == false || scd30CheckCRC8(&frame[15]) == false)
+        return false;
+    humidity = scd30FrameField(frame, SCD30_FRAME_HUMIDITY);
+
+    return true;
+}
+
+//the parser as readMeasurement() used it before, a switch on every byte and the bitwise CRC
+//kept to measure scd30ParseFrame() against, see benchmarkExample example
+bool scd30ParseFrameLoop(const uint8_t frame[], uint32_t &co2, uint32_t &temperature, uint32_t &humidity)
+{
+    uint32_t tempCO2 = 0;
+    uint32_t tempHumidity = 0;
+    uint32_t tempTemperature = 0;
+
+    for (uint8_t b = 0; b < SCD30_FRAME_SIZE; b++) 
+    {
+        uint8_t incoming = frame[b];
+
+        switch(b) 
+        {
+            //bytes 1, 2, 4 and 5 contain CO2 data
+            case 0: 
+            case 1:
+            //byte 3 cotains CRC
+            case 3:
+            case 4:
+                tempCO2 <<= 8;
+                tempCO2 |= incoming;
+                break;
+            //byte 6 cotains CRC
+            //bytes 7, 8, 10 and 11 contain temperature data
+            case 6: 
+            case 7:
+            //byte 9 contains CRC
+            case 9:
+            case 10:
+                tempTemperature <<= 8;
+                tempTemperature |= incoming;
+                break;
+            //byte 12 cotains CRC
+            //bytes 13, 14, 16, 17 contain humidity data
+            case 12: 
+            case 13:
+            //byte 15 contains CRC
+            case 15:
+            case 16:
+                tempHumidity <<= 8;
+                tempHumidity |= incoming;
+                break;
+            //byte 18 contains CRC
+            default:
+                if (scd30ComputeCRC8Bitwise(&frame[b - 2], 2) != incoming)
+                    return false;
+                break;
+        }
+    }
+
+    co2 = tempCO2;
+    temperature = tempTemperature;
+    humidity = tempHumidity;
+
+    return true;
+}
+
+SCD30Frame::SCD30Frame(const uint8_t *frame) : frame(frame)
+{
+    //constructor
+}
+
+bool SCD30Frame::isValid()
+{
+    return scd30CheckFrame(frame);
+}
+
+const uint8_t* SCD30Frame::getData()
+{
+    return frame;
+}
+
+uint32_t SCD30Frame::getCO2Bits()
+{
+    return scd30FrameField(frame, SCD30_FRAME_CO2);
+}
+
+uint32_t SCD30Frame::getTemperatureBits()
+{
+    return scd30FrameField(frame, SCD30_FRAME_TEMPERATURE);
+}
+
+uint32_t SCD30Frame::getHumidityBits()
+{
+    return scd30FrameField(frame, SCD30_FRAME_HUMIDITY);
+}
+
+#ifndef SCD30_FIXED_POINT
+//copy the bit pattern into a float, memcpy is the portable way and compiles to a plain copy
+static float bitsToFloat(uint32_t bits)
+{
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+float SCD30Frame::getCO2()
+{
+    return bitsToFloat(getCO2Bits());
+}
+
+float SCD30Frame::getTemperature()
+{
+    return bitsToFloat(getTemperatureBits());
+}
+
+float SCD30Frame::getHumidity()
+{
+    return bitsToFloat(getHumidityBits());
+}
+#endif
+
+uint16_t SCD30Frame::getCO2ppm()
+{
+    int32_t ppm = scd30FloatBitsToFixed(getCO2Bits(), 1);
+
+    if (ppm < 0) return 0;
+    if (ppm > UINT16_MAX) return UINT16_MAX;
+    return ppm;
+}
+
+int16_t SCD30Frame::getTemperatureCentiC()
+{
+    int32_t centi = scd30FloatBitsToFixed(getTemperatureBits(), 100);
+
+    if (centi < INT16_MIN) return INT16_MIN;
+    if (centi > INT16_MAX) return INT16_MAX;
+    return centi;
+}
+
+uint16_t SCD30Frame::getHumidityCentiPct()
+{
+    int32_t centi = scd30FloatBitsToFixed(getHumidityBits(), 100);
+
+    if (centi < 0) return 0;
+    if (centi > UINT16_MAX) return UINT16_MAX;
+    return centi;
+}
@@ -0,0 +1,59 @@
+/*
+Raw measurement frame of the SCD30 and a lazy decoder for it.
+
+The frame is the 18 bytes sent after the read measurement command, see 1.4.4 in the interface description document:
+CO2, temperature and humidity as big endian IEEE-754 floats, every 2 bytes followed by their CRC.
+
+SCD30::readRawFrame() reads the frame into a buffer of the caller and only checks the CRCs.
+SCD30Frame works on that buffer in place, a field is only parsed when it is asked for,
+so a frame that is just forwarded is never decoded.
+*/
+
+#ifndef SCD30_Frame_h
+#define SCD30_Frame_h
+
+#include <stdint.h>
+
+#define SCD30_FRAME_SIZE 18
+#define SCD30_FRAME_CO2 0 //offset of the CO2 field
+#define SCD30_FRAME_TEMPERATURE 6 //offset of the temperature field
+#define SCD30_FRAME_HUMIDITY 12 //offset of the humidity field
+
+bool scd30CheckFrame(const uint8_t frame[]); //checks all six CRC bytes of a frame
+bool scd30ParseFrame(const uint8_t frame[], uint32_t &co2, uint32_t &temperature, uint32_t &humidity); //checks the CRCs and gets the three bit patterns in one pass
+bool scd30ParseFrameLoop(const uint8_t frame[], uint32_t &co2, uint32_t &temperature, uint32_t &humidity); //same, the way it was done before, only used as a baseline
+
+//gets the IEEE-754 bit pattern of the field at offset
+//bytes offset, offset + 1, offset + 3 and offset + 4 hold the float, offset + 2 and offset + 5 the CRCs
+inline uint32_t scd30FrameField(const uint8_t frame[], uint8_t offset)
+{
+    return ((uint32_t)frame[offset] << 24) | ((uint32_t)frame[offset + 1] << 16) | ((uint32_t)frame[offset + 3] << 8) | frame[offset + 4];
+}
+
+class SCD30Frame
+{
+    public:
+        SCD30Frame(const uint8_t *frame); //constructor, the frame is not copied and has to outlive the decoder
+
+        bool isValid(); //checks the CRC bytes, readRawFrame() already did that
+        const uint8_t* getData(); //gets the raw 18 bytes
+
+        uint32_t getCO2Bits(); //gets the IEEE-754 bit pattern of the CO2 field
+        uint32_t getTemperatureBits();
+        uint32_t getHumidityBits();
+
+#ifndef SCD30_FIXED_POINT
+        float getCO2(); //gets CO2 in ppm
+        float getTemperature(); //gets temperature in degC
+        float getHumidity(); //gets relative humidity in %
+#endif
+
+        uint16_t getCO2ppm(); //gets CO2 in ppm, rounded, integer operations only
+        int16_t getTemperatureCentiC(); //gets temperature in 0.01 degC, integer operations only
+        uint16_t getHumidityCentiPct(); //gets relative humidity in 0.01 %, integer operations only
+
+    private:
+        const uint8_t *frame;
+};
+
+#endif
@@ -0,0 +1,261 @@
+/*
+Fusion of several SCD30 sensors in one zone, built on SCD30Array.
+See SCD30_Group.h for details.
+*/
+
+#include "SCD30_Group.h"
+
+SCD30Group::SCD30Group(SCD30Array &array, uint32_t window) : array(&array), window(window)
+{
+    //constructor
+}
+
+//sets the same interval on all sensors and restarts their measurements back to back, the cycles then start
+//within a few ms of each other and the samples of one cycle come in close together
+//returns true if all sensors responded
+boolean SCD30Group::begin(uint16_t interval)
+{
+    boolean success = true;
+    uint8_t count = array->getCount();
+
+    for (uint8_t i = 0; i < count; i++)
+        array->getSensor(i).setMeasurementInterval(interval);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (array->getSensor(i).beginMeasuring() == false)
+            success = false;
+    }
+
+    collected = 0;
+    waiting = 0;
+    return success;
+}
+
+//does one step of the array, call it from loop() as often as possible
+//returns true when a cycle was closed, either because every sensor delivered or because the window has passed
+boolean SCD30Group::update()
+{
+    uint8_t count = array->getCount();
+    if (count > SCD30_GROUP_MAX_SENSORS)
+        count = SCD30_GROUP_MAX_SENSORS;
+
+    uint8_t all = (uint8_t)((1u << count) - 1);
+    int8_t index = array->update();
+
+    if (index >= 0 && index < count)
+    {
+        const SCD30Measurement &sample = array->getSensor(index).getMeasurement();
+        uint8_t bit = 1 << index;
+
+        if (collected == 0)
+            cycleStart = sample.timestamp;
+
+        if ((collected & bit) == 0)
+        {
+            samples[index] = sample;
+            collected |= bit;
+        }
+        else
+        {
+            early[index] = sample; //this sensor is a cycle ahead, the newest sample is kept
+            waiting |= bit;
+        }
+    }
+
+    if (collected == 0)
+        return false;
+
+    if (collected != all && millis() - cycleStart < window)
+        return false;
+
+    if (collected != all)
+        incomplete++;
+
+    fuse();
+    cycles++;
+
+    //samples that came in early start the next cycle
+    collected = waiting;
+    waiting = 0;
+
+    boolean first = true;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if ((collected & (1 << i)) == 0)
+            continue;
+
+        samples[i] = early[i];
+
+        if (first == true || (int32_t)(early[i].timestamp - cycleStart) < 0)
+            cycleStart = early[i].timestamp;
+
+        first = false;
+    }
+
+    return true;
+}
+
+void SCD30Group::fuse()
+{
+    float values[SCD30_GROUP_MAX_SENSORS];
+    uint8_t indices[SCD30_GROUP_MAX_SENSORS];
+    uint8_t n = 0;
+    uint32_t first = 0;
+    uint32_t last = 0;
+
+    for (uint8_t i = 0; i < SCD30_GROUP_MAX_SENSORS; i++)
+    {
+        if ((collected & (1 << i)) == 0)
+            continue;
+
+        if (n == 0 || (int32_t)(samples[i].timestamp - first) < 0)
+            first = samples[i].timestamp;
+        if (n == 0 || (int32_t)(samples[i].timestamp - last) > 0)
+            last = samples[i].timestamp;
+
+        indices[n++] = i;
+    }
+
+    zone.sensors = n;
+    zone.outliers = 0;
+    zone.timestamp = first;
+    zone.spread = last - first;
+
+    for (uint8_t q = 0; q < SCD30_QUANTITY_COUNT; q++)
+    {
+        for (uint8_t k = 0; k < n; k++)
+            values[k] = value(samples[indices[k]], (SCD30Quantity)q);
+
+        fuse((SCD30Quantity)q, values, indices, n);
+    }
+}
+
+//median, median absolute deviation as the spread, values further than outlierLimit deviations are rejected
+//the deviation is at least minDeviation, so that a few very close sensors do not reject the normal noise of one
+void SCD30Group::fuse(SCD30Quantity quantity, float values[], uint8_t indices[], uint8_t n)
+{
+    float sorted[SCD30_GROUP_MAX_SENSORS];
+    float deviations[SCD30_GROUP_MAX_SENSORS];
+
+    for (uint8_t k = 0; k < n; k++)
+        sorted[k] = values[k];
+
+    sort(sorted, n);
+    float center = median(sorted, n);
+
+    for (uint8_t k = 0; k < n; k++)
+        deviations[k] = fabs(values[k] - center);
+
+    sort(deviations, n);
+    float deviation = median(deviations, n);
+    if (deviation < minDeviation[quantity])
+        deviation = minDeviation[quantity];
+
+    float limit = outlierLimit * deviation;
+    float sum = 0;
+    uint8_t used = 0;
+
+    for (uint8_t k = 0; k < n; k++)
+    {
+        if (fabs(values[k] - center) > limit)
+        {
+            zone.outliers |= 1 << indices[k];
+            continue;
+        }
+
+        sum += values[k];
+        used++;
+    }
+
+    zone.median[quantity] = center;
+    zone.mean[quantity] = (used > 0) ? sum / used : center;
+    zone.used[quantity] = used;
+}
+
+float SCD30Group::value(const SCD30Measurement &sample, SCD30Quantity quantity)
+{
+    switch (quantity)
+    {
+        case SCD30_QUANTITY_TEMPERATURE:
+            return sample.temperature;
+        case SCD30_QUANTITY_HUMIDITY:
+            return sample.humidity;
+        default:
+            return sample.co2;
+    }
+}
+
+float SCD30Group::median(float sorted[], uint8_t n)
+{
+    if (n == 0)
+        return 0;
+
+    if (n % 2 == 1)
+        return sorted[n / 2];
+
+    return (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+//insertion sort, at most SCD30_GROUP_MAX_SENSORS values
+void SCD30Group::sort(float values[], uint8_t n)
+{
+    for (uint8_t i = 1; i < n; i++)
+    {
+        float v = values[i];
+        uint8_t j = i;
+
+        while (j > 0 && values[j - 1] > v)
+        {
+            values[j] = values[j - 1];
+            j--;
+        }
+
+        values[j] = v;
+    }
+}
+
+void SCD30Group::setWindow(uint32_t window)
+{
+    this->window = window;
+}
+
+void SCD30Group::setOutlierLimit(float factor)
+{
+    outlierLimit = factor;
+}
+
+void SCD30Group::setMinDeviation(SCD30Quantity quantity, float deviation)
+{
+    minDeviation[quantity] = deviation;
+}
+
+const SCD30Zone& SCD30Group::getZone()
+{
+    return zone;
+}
+
+float SCD30Group::getMedian(SCD30Quantity quantity)
+{
+    return zone.median[quantity];
+}
+
+float SCD30Group::getMean(SCD30Quantity quantity)
+{
+    return zone.mean[quantity];
+}
+
+uint8_t SCD30Group::getOutliers()
+{
+    return zone.outliers;
+}
+
+uint32_t SCD30Group::getCycles()
+{
+    return cycles;
+}
+
+uint32_t SCD30Group::getIncomplete()
+{
+    return incomplete;
+}
@@ -0,0 +1,78 @@
+/*
+Fusion of several SCD30 sensors in one zone, built on SCD30Array.
+
+begin() sets the same interval on all sensors and restarts them back to back, so their cycles run in step.
+update() drives the array and collects one sample per sensor. A group cycle starts with the first sample and ends
+when every sensor delivered, or when the window has passed since the first sample. Samples of the same sensor
+that come in later are kept for the next cycle.
+
+At the end of a cycle the zone values are computed once: per quantity the median, then the values further
+than the outlier limit from the median are rejected and the mean of the remaining ones is taken.
+The getters only return these results.
+*/
+
+#ifndef SCD30_Group_h
+#define SCD30_Group_h
+
+#include "SCD30_Array.h"
+#include "SCD30_Stats.h"
+
+#define SCD30_GROUP_MAX_SENSORS 8
+#define SCD30_GROUP_DEFAULT_WINDOW 1000 //ms from the first to the last sample of a cycle
+#define SCD30_GROUP_DEFAULT_OUTLIER 3.0f //outlier limit as a multiple of the median absolute deviation
+
+//zone values of one group cycle
+struct SCD30Zone
+{
+    float median[SCD30_QUANTITY_COUNT];
+    float mean[SCD30_QUANTITY_COUNT]; //mean of the values that were not rejected
+    uint8_t used[SCD30_QUANTITY_COUNT]; //number of values that went into the mean
+    uint8_t sensors; //number of sensors that delivered in this cycle
+    uint8_t outliers; //bit per sensor index, set if any of its values was rejected
+    uint32_t timestamp; //millis() of the first sample of the cycle
+    uint32_t spread; //ms between the first and the last sample of the cycle
+};
+
+class SCD30Group
+{
+    public:
+        SCD30Group(SCD30Array &array, uint32_t window = SCD30_GROUP_DEFAULT_WINDOW); //constructor, the array holds at most SCD30_GROUP_MAX_SENSORS sensors
+
+        boolean begin(uint16_t interval = 2); //sets interval s on all sensors and restarts them together, call after array.begin()
+        boolean update(); //does one step of the array, returns true when a group cycle was completed and the zone values are new
+
+        void setWindow(uint32_t window); //sets ms a cycle waits for the remaining sensors
+        void setOutlierLimit(float factor); //sets how many median absolute deviations a value may be away from the median
+        void setMinDeviation(SCD30Quantity quantity, float deviation); //sets the smallest deviation used for the outlier limit, e.g. 10 ppm
+
+        const SCD30Zone& getZone(); //gets results of the last completed cycle
+        float getMedian(SCD30Quantity quantity);
+        float getMean(SCD30Quantity quantity);
+        uint8_t getOutliers(); //gets bit per sensor rejected in the last cycle
+        uint32_t getCycles(); //gets number of completed cycles
+        uint32_t getIncomplete(); //gets number of cycles closed by the window before every sensor delivered
+
+    private:
+        void fuse(); //computes the zone values from the collected samples
+        void fuse(SCD30Quantity quantity, float values[], uint8_t indices[], uint8_t n);
+        static float value(const SCD30Measurement &sample, SCD30Quantity quantity);
+        static float median(float sorted[], uint8_t n);
+        static void sort(float values[], uint8_t n);
+
+        SCD30Array *array;
+        uint32_t window;
+        float outlierLimit = SCD30_GROUP_DEFAULT_OUTLIER;
+        float minDeviation[SCD30_QUANTITY_COUNT] = {10.0f, 0.1f, 0.5f}; //ppm, °C, %RH, about the noise of one sensor
+
+        SCD30Measurement samples[SCD30_GROUP_MAX_SENSORS];
+        SCD30Measurement early[SCD30_GROUP_MAX_SENSORS]; //second sample of a sensor during a cycle, kept for the next one
+        uint8_t collected = 0; //bit per sensor with a sample in this cycle
+        uint8_t waiting = 0; //bit per sensor with a sample in early
+        uint32_t cycleStart = 0;
+
+        SCD30Zone zone = {};
+        uint32_t cycles = 0;
+        uint32_t incomplete = 0;
+};
+
+#endif
@@ -19,8 +19,42 @@ https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.
 */
 
 #include "SCD30_I2C_lib.h"
+#include "SCD30_SampleBuffer.h"
+#include "SCD30_Stats.h"
+#include "SCD30_Deadband.h"
+
+SCD30* SCD30::interruptInstances[SCD30_MAX_INTERRUPTS] = { NULL };
+
+//command of every cached setting, in the order of SCD30::Setting
+const uint16_t SCD30::settingCommands[SETTING_COUNT] = {
+    SCD30_SET_MEASUREMENT_INTERVAL,
+    SCD30_SET_AUTOMATIC_SELFCALIBRATION,
+    SCD30_SET_FORCED_RECALIBRATION,
+    SCD30_SET_TEMPERATURE_OFFSET,
+    SCD30_SET_ALTITUDE_COMPENSATION,
+    SCD30_START_CONTINUOUS_MEASUREMENT
+};
+
+//the sensor only takes 700 to 1200 mBar, anything else deactivates the pressure compensation
+static uint16_t validPressure(uint16_t ambientPressure)
+{
+    if (ambientPressure < 700 || ambientPressure > 1200)
+        return 0;
+
+    return ambientPressure;
+}
+
+SCD30::SCD30(TwoWire &wirePort) : wireTransport(wirePort), transport(&wireTransport)
+{
+    //constructor
+}
 
-SCD30::SCD30()
+SCD30::SCD30(SCD30Mux &mux, uint8_t muxChannel) : wireTransport(mux.getWire(), &mux, muxChannel), transport(&wireTransport)
+{
+    //constructor
+}
+
+SCD30::SCD30(SCD30Transport &transport) : transport(&transport)
 {
     //constructor
 }
@@ -28,11 +62,30 @@ SCD30::SCD30()
 SCD30::~SCD30()
 {
     //destructor
+    detachReadyInterrupt();
 }
 
-boolean SCD30::begin()
+//the SCD30 supports up to 100 kHz, lower clocks help with long cables
+boolean SCD30::begin(uint32_t clockSpeed)
 {
-    Wire.begin(); //initiate the Wire library and join the I2C bus as a master
+    return begin(SCD30_COLD_START, clockSpeed);
+}
+
+//SCD30_COLD_START always (re)starts the measurements with a 2 second interval, the first sample comes one interval later
+//SCD30_WARM_START leaves a sensor alone that already measures with a 2 second interval, e.g. after a reset of the MCU only,
+//a sample that is waiting can then be read right away, it waits up to one interval for a sample before it decides
+boolean SCD30::begin(SCD30BeginMode mode, uint32_t clockSpeed)
+{
+    transport->setClock(clockSpeed); //limited to SCD30_I2C_MAX_CLOCK
+    transport->begin(); //initiate the Wire library and join the I2C bus as a master
+
+    if (mode == SCD30_WARM_START)
+    {
+        SCD30Config config; //2 seconds, what a cold start sets
+
+        if (canResume(config, false) == true)
+            return true;
+    }
 
     //check for device to respond correctly
     if(beginMeasuring() == true) //start continuous measurements
@@ -44,6 +97,53 @@ boolean SCD30::begin()
     return false; //something went wrong
 }
 
+//same with a whole configuration, see applyConfig()
+//with SCD30_WARM_START nothing is written if interval, ASC, temperature offset and altitude already match
+//and a sample comes within one interval, the ambient pressure can not be read back and is assumed to match as well
+boolean SCD30::begin(const SCD30Config &config, SCD30BeginMode mode, uint32_t clockSpeed)
+{
+    transport->setClock(clockSpeed); //limited to SCD30_I2C_MAX_CLOCK
+    transport->begin(); //initiate the Wire library and join the I2C bus as a master
+
+    if (mode == SCD30_WARM_START)
+        canResume(config, true); //on a match the pressure is cached, so applyConfig() has nothing to write
+
+    return applyConfig(config);
+}
+
+//checks if the sensor already measures with config, the settings are read back into the cache on the way
+//compares only the interval unless all is set
+//the settings are kept in NVM also by a sensor that was stopped, so it only measures if a sample comes within one interval
+//on a match the sensor kept measuring through the reset of the MCU, the ambient pressure of config is then
+//taken as what the sensor has, so that the start command that would restart the cycle is not sent again
+//otherwise the start command is due, the caller sends it with the pressure it has
+boolean SCD30::canResume(const SCD30Config &config, boolean all)
+{
+    SCD30Settings current;
+
+    settingsValid &= ~(1 << SETTING_PRESSURE); //not known to measure until a sample is seen
+
+    if (waitForFirmware(SCD30_BOOT_TIMEOUT) == false || readAllSettings(current) != SCD30_OK)
+        return false;
+
+    if (current.measurementInterval != config.measurementInterval)
+        return false;
+
+    if (all == true && (current.automaticSelfCalibration != config.automaticSelfCalibration || current.temperatureOffset != config.temperatureOffset || current.altitude != config.altitude))
+        return false;
+
+    if (waitForData((uint32_t)current.measurementInterval * 1000 + SCD30_WAKE_SLACK) == false)
+        return false; //stopped before the reset, or the state can not be read
+
+    if (all == true)
+    {
+        settings[SETTING_PRESSURE] = validPressure(config.ambientPressure);
+        settingsValid |= 1 << SETTING_PRESSURE;
+    }
+
+    return true;
+}
+
 //begins continuous measurements, status is saved in non-volatile memory
 //the device continues measuring after repowering without sending the measurement command 
 //returns true if successful
@@ -57,47 +157,72 @@ boolean SCD30::beginMeasuring(void)
 //see 1.4.1 in document
 boolean SCD30::beginMeasuring(uint16_t ambientPressureOffset)
 {
-  return(sendCommand(SCD30_START_CONTINUOUS_MEASUREMENT, ambientPressureOffset));
+  return(writeSetting(SETTING_PRESSURE, ambientPressureOffset, true)); //always sent, the command also starts the measurements
 }
 
 //stops continuous measuring, measuring can be resumed with beginMeasuring
 //see 1.4.2 in document
 boolean SCD30::stopMeasuring()
 {
+    settingsValid &= ~(1 << SETTING_PRESSURE); //measurements have to be started again, with whatever pressure is set then
+    sequenceSynced = false;
     return(sendCommand(SCD30_STOP_CONTINUOUS_MEASUREMENT));
 }
 
+//starts the measurements again with the ambient pressure of the last beginMeasuring() or setAmbientPressure(),
+//stopMeasuring() keeps that value in the cache, so duty cycled measurements keep their pressure compensation
+//see 1.4.1 in document
+boolean SCD30::resumeMeasuring()
+{
+    return(writeSetting(SETTING_PRESSURE, settings[SETTING_PRESSURE], true));
+}
+
 //returns true when data from the sensor is available
+//getLastError() is SCD30_ERROR_NOT_READY when the sensor answered, but has no new sample
 //see 1.4.4 in document
 boolean SCD30::dataAvailable()
 {
-    uint16_t response = readRegister(SCD30_GET_READY_STATUS);
+    SCD30Error error;
 
-    if (response == 1) return true;
-    else return false;
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        uint16_t response = 0;
+        error = transferRegister(SCD30_GET_READY_STATUS, response);
+
+        if (error == SCD30_OK && response != 1)
+            error = SCD30_ERROR_NOT_READY;
+
+        SCD30_INSTRUMENT_READY(error);
+
+        if (retry(record(error), attempt) == false)
+            break;
+    }
+
+    return (error == SCD30_OK);
 }
 
 //enables automatic self calibration 
 //see 1.4.5 in document
 void SCD30::enableAutomaticSelfCalibration()
 {
-    sendCommand(SCD30_SET_AUTOMATIC_SELFCALIBRATION, 1);
+    writeSetting(SETTING_ASC, 1, false);
 }
 
 //disables automatic self calibration 
 //see 1.4.5 in document
 void SCD30::disableAutomaticSelfCalibration()
 {
-    sendCommand(SCD30_SET_AUTOMATIC_SELFCALIBRATION, 0);
+    writeSetting(SETTING_ASC, 0, false);
 }
 
 //sets reference CO2 concentration in ppm
 //valid values in range from 400 to 2000 ppm
+//always sent, even if the value did not change, every write triggers a recalibration
 //see 1.4.5 in document
 void SCD30::setForcedRecalibrationValue(uint16_t concentration)
 {
     if (concentration < 400 || concentration > 2000) return;
-    sendCommand(SCD30_SET_FORCED_RECALIBRATION, concentration);
+    writeSetting(SETTING_FRC, concentration, true);
 }
 
 //sets measurement interval
@@ -105,7 +230,7 @@ void SCD30::setForcedRecalibrationValue(uint16_t concentration)
 //see 1.4.3 in document
 void SCD30::setMeasurementInterval(uint16_t interval)
 {
-    sendCommand(SCD30_SET_MEASUREMENT_INTERVAL, interval);
+    writeSetting(SETTING_INTERVAL, interval, false);
 }
 
 //sets temperature offset
@@ -113,12 +238,14 @@ void SCD30::setMeasurementInterval(uint16_t interval)
 void SCD30::setTemperatureOffset(float tempOffset)
 {
     uint16_t tickOffest = tempOffset * 100;
-    sendCommand(SCD30_SET_TEMPERATURE_OFFSET, tickOffest);
+    writeSetting(SETTING_TEMPERATURE_OFFSET, tickOffest, false);
 }
 
 //sets ambient pressure after initialization
 //ambient pressure can also be set with beginMeasuring(uint16_t ambientPressureOffset)
 //valid values in range from 700 to 1200 mBar
+//the pressure is sent with the start continuous measurement command, which restarts the measurement cycle,
+//so it is only sent when the value changed
 //see 1.4.1 in document
 void SCD30::setAmbientPressure(uint16_t ambientPressure)
 {
@@ -127,21 +254,23 @@ void SCD30::setAmbientPressure(uint16_t ambientPressure)
         ambientPressure = 0;
     }
 
-    sendCommand(SCD30_START_CONTINUOUS_MEASUREMENT, ambientPressure);
+    writeSetting(SETTING_PRESSURE, ambientPressure, false);
 }
 
 //sets altitude compensation, valid values range from 0 upwards, in m
 //see 1.4.7 in document
 void SCD30::setAltitudeCompensation(uint16_t altitude)
 {
-    sendCommand(SCD30_SET_ALTITUDE_COMPENSATION, altitude);
+    writeSetting(SETTING_ALTITUDE, altitude, false);
 }
 
 //gets set measurement interval 
+//answered from the cache once the value is known, see refresh()
 //see 1.4.3 in document
 uint16_t SCD30::getMeasurementInterval()
 {
-    uint16_t interval = readRegister(SCD30_SET_MEASUREMENT_INTERVAL);
+    uint16_t interval = 0;
+    readSetting(SETTING_INTERVAL, interval);
     return interval;
 }
 
@@ -149,7 +278,8 @@ uint16_t SCD30::getMeasurementInterval()
 //see 1.4.5 in document
 boolean SCD30::getAutomaticSelfCalibration()
 {
-    uint16_t ASC = readRegister(SCD30_SET_AUTOMATIC_SELFCALIBRATION);
+    uint16_t ASC = 0;
+    readSetting(SETTING_ASC, ASC);
     if (ASC == 1) return true;
     else return false;
 }
@@ -159,7 +289,8 @@ boolean SCD30::getAutomaticSelfCalibration()
 //see 1.4.5 in document
 uint16_t SCD30::getForcedRecalibrationValue()
 {
-    uint16_t FRC = readRegister(SCD30_SET_FORCED_RECALIBRATION);
+    uint16_t FRC = 0;
+    readSetting(SETTING_FRC, FRC);
     return FRC;
 }
 
@@ -167,7 +298,8 @@ uint16_t SCD30::getForcedRecalibrationValue()
 //see 1.4.6 in document
 uint16_t SCD30::getTemperatureOffset()
 {
-    uint16_t temperature = readRegister(SCD30_SET_TEMPERATURE_OFFSET);
+    uint16_t temperature = 0;
+    readSetting(SETTING_TEMPERATURE_OFFSET, temperature);
     return temperature;
 }
 
@@ -175,220 +307,922 @@ uint16_t SCD30::getTemperatureOffset()
 //see 1.4.7 in document
 uint16_t SCD30::getAltitudeCompensation()
 {
-    uint16_t interval = readRegister(SCD30_SET_ALTITUDE_COMPENSATION);
-    return interval;
+    uint16_t altitude = 0;
+    readSetting(SETTING_ALTITUDE, altitude);
+    return altitude;
+}
+
+//forgets the cached settings and reads them from the sensor again
+//the ambient pressure can not be read back, it stays cached
+//returns true if all settings were read
+boolean SCD30::refresh()
+{
+    boolean success = true;
+
+    settingsValid &= (1 << SETTING_PRESSURE);
+
+    for (uint8_t i = 0; i < SETTING_COUNT; i++)
+    {
+        uint16_t value;
+
+        if (i != SETTING_PRESSURE && readSetting((Setting)i, value) == false)
+            success = false;
+    }
+
+    return success;
+}
+
+//reads every setting the sensor can report and its firmware version, straight from the sensor
+//each word is CRC checked, the cache of the getters is updated with what was read
+//the read delay is the only wait, each register is one command and one 3 byte read
+//the whole sequence is retried according to the retry policy
+//settings is only filled if SCD30_OK is returned
+SCD30Error SCD30::readAllSettings(SCD30Settings &settings)
+{
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        if (startReadSettings() == false)
+            return SCD30_ERROR_NOT_READY; //a non-blocking read or job is in progress
+
+        SCD30ReadState state;
+        do
+        {
+            state = pollSettings(settings);
+        } while (state == SCD30_READ_PENDING);
+
+        if (state == SCD30_READ_DONE)
+            return SCD30_OK;
+
+        if (retry(lastError, attempt) == false)
+            return lastError;
+    }
+}
+
+//starts reading all settings as a non-blocking job, call pollSettings() until it returns SCD30_READ_DONE or SCD30_READ_FAILED
+//no other read may use the sensor meanwhile, startRead() and the like refuse while the job runs
+//returns false if a read or job is already in progress
+boolean SCD30::startReadSettings()
+{
+    if (busy() == true)
+        return false;
+
+    settingsStep = 0;
+    settingsWritten = false;
+    settingsState = SCD30_READ_PENDING;
+    return true;
+}
+
+//does at most one transaction and never waits: the command of the next register, or its response once the read delay has passed
+//returns SCD30_READ_PENDING until all registers are read, then SCD30_READ_DONE with settings filled,
+//or SCD30_READ_FAILED on the first failed transaction, see getLastError()
+//many sensors can be swept together this way, each call keeps the bus for one short transaction only
+SCD30ReadState SCD30::pollSettings(SCD30Settings &settings)
+{
+    if (settingsState != SCD30_READ_PENDING)
+        return SCD30_READ_IDLE;
+
+    static_assert(SCD30_SETTINGS_STEPS == SETTING_PRESSURE + 1, "every readable setting and the firmware version is one step");
+
+    //the readable settings come first in settingCommands, the firmware version is the last step
+    uint16_t command = (settingsStep < SETTING_PRESSURE) ? settingCommands[settingsStep] : SCD30_READ_FIRMWARE_VERSION;
+
+    if (settingsWritten == false)
+    {
+        if (record(transport->writeCommand(command)) != SCD30_OK)
+        {
+            settingsState = SCD30_READ_IDLE;
+            return SCD30_READ_FAILED;
+        }
+
+        settingsWritten = true;
+        settingsStarted = micros();
+        return SCD30_READ_PENDING;
+    }
+
+    if ((uint32_t)(micros() - settingsStarted) < transport->getReadDelay())
+        return SCD30_READ_PENDING; //too early, the sensor is not ready to send the data
+
+    uint8_t data[3];
+    SCD30Error error = transport->read(data, 3); //2 data bytes and their CRC
+
+    if (error == SCD30_OK && scd30CheckCRC8(data) == false)
+        error = SCD30_ERROR_CRC;
+
+    if (record(error) != SCD30_OK)
+    {
+        settingsState = SCD30_READ_IDLE;
+        return SCD30_READ_FAILED;
+    }
+
+    settingsValues[settingsStep] = (data[0] << 8) | data[1];
+    settingsWritten = false;
+
+    if (++settingsStep < SCD30_SETTINGS_STEPS)
+        return SCD30_READ_PENDING;
+
+    settingsState = SCD30_READ_IDLE;
+
+    //what was read is what the sensor has, so the cache is updated as well
+    for (uint8_t i = 0; i < SETTING_PRESSURE; i++)
+    {
+        this->settings[i] = settingsValues[i];
+        settingsValid |= 1 << i;
+    }
+
+    uint16_t version = settingsValues[SCD30_SETTINGS_STEPS - 1];
+    firmwareVersion[0] = version >> 8;
+    firmwareVersion[1] = version & 0xFF;
+
+    settings.measurementInterval = settingsValues[SETTING_INTERVAL];
+    settings.automaticSelfCalibration = (settingsValues[SETTING_ASC] == 1);
+    settings.forcedRecalibrationValue = settingsValues[SETTING_FRC];
+    settings.temperatureOffset = settingsValues[SETTING_TEMPERATURE_OFFSET];
+    settings.altitude = settingsValues[SETTING_ALTITUDE];
+    settings.firmwareVersion[0] = firmwareVersion[0];
+    settings.firmwareVersion[1] = firmwareVersion[1];
+
+    return SCD30_READ_DONE;
+}
+
+//applies a whole configuration, only the settings that differ from what the sensor has are written
+//settings that do not affect the measurement cycle are written first, the interval next,
+//and last the start continuous measurement command with the ambient pressure, which restarts the cycle only once
+//the sensor is first given up to SCD30_BOOT_TIMEOUT to answer, so this can be called right after softReset()
+//values already on the sensor are read back first, the settings are kept in non-volatile memory
+//and we do not want to rewrite them on every boot
+//returns true if all settings were applied
+boolean SCD30::applyConfig(const SCD30Config &config)
+{
+    boolean success = true;
+
+    if (waitForFirmware(SCD30_BOOT_TIMEOUT) == false)
+        return false; //sensor is not there
+
+    if (updateSetting(SETTING_ASC, config.automaticSelfCalibration ? 1 : 0) == false)
+        success = false;
+
+    if (updateSetting(SETTING_TEMPERATURE_OFFSET, config.temperatureOffset) == false)
+        success = false;
+
+    if (updateSetting(SETTING_ALTITUDE, config.altitude) == false)
+        success = false;
+
+    if (updateSetting(SETTING_INTERVAL, config.measurementInterval) == false)
+        success = false;
+
+    //only sent if the pressure changed or we do not know if the sensor is measuring
+    if (writeSetting(SETTING_PRESSURE, validPressure(config.ambientPressure), false) == false)
+        success = false;
+
+    return success;
+}
+
+//waits until the sensor answers, checked by reading the firmware version
+//the time between checks starts at SCD30_BACKOFF_START and doubles up to SCD30_BACKOFF_MAX
+//returns false if the sensor did not answer within timeout ms
+boolean SCD30::waitForFirmware(uint32_t timeout)
+{
+    uint32_t start = millis();
+    uint32_t backoff = SCD30_BACKOFF_START;
+    uint16_t version;
+
+    while (readRegister(SCD30_READ_FIRMWARE_VERSION, version) != SCD30_OK)
+    {
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= timeout)
+            return false;
+
+        delay((backoff < timeout - elapsed) ? backoff : timeout - elapsed);
+
+        backoff *= 2;
+        if (backoff > SCD30_BACKOFF_MAX)
+            backoff = SCD30_BACKOFF_MAX;
+    }
+
+    return true;
+}
+
+//waits until a sample is available, with the same backoff as waitForFirmware()
+//returns false if no sample was ready within timeout ms
+boolean SCD30::waitForData(uint32_t timeout)
+{
+    uint32_t start = millis();
+    uint32_t backoff = SCD30_BACKOFF_START;
+
+    while (dataAvailable() == false)
+    {
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= timeout)
+            return false;
+
+        delay((backoff < timeout - elapsed) ? backoff : timeout - elapsed);
+
+        backoff *= 2;
+        if (backoff > SCD30_BACKOFF_MAX)
+            backoff = SCD30_BACKOFF_MAX;
+    }
+
+    return true;
+}
+
+//reads a setting, from the cache if it is there, and only writes it if it differs
+//used where a write would be wasted, the sensor keeps its settings in non-volatile memory
+boolean SCD30::updateSetting(Setting setting, uint16_t value)
+{
+    uint16_t current;
+
+    if (readSetting(setting, current) == true && current == value)
+        return true;
+
+    return writeSetting(setting, value, true);
+}
+
+//writes a setting, skipped if the cache says the sensor already has this value, unless force is set
+//a failed write clears the cached value, since we do not know what the sensor has now
+boolean SCD30::writeSetting(Setting setting, uint16_t value, boolean force)
+{
+    uint8_t mask = 1 << setting;
+
+    if (force == false && (settingsValid & mask) != 0 && settings[setting] == value)
+        return true; //nothing to do
+
+    if (sendCommand(settingCommands[setting], value) == false)
+    {
+        settingsValid &= ~mask;
+        return false;
+    }
+
+    settings[setting] = value;
+    settingsValid |= mask;
+
+    if (setting == SETTING_INTERVAL || setting == SETTING_PRESSURE)
+        sequenceSynced = false; //the measurement cycle restarts, the next gap says nothing about missed samples
+
+    return true;
+}
+
+//reads a setting from the cache, the sensor is only asked if the value is not cached yet
+boolean SCD30::readSetting(Setting setting, uint16_t &value)
+{
+    uint8_t mask = 1 << setting;
+
+    if ((settingsValid & mask) == 0)
+    {
+        if (setting == SETTING_PRESSURE || readRegister(settingCommands[setting], settings[setting]) != SCD30_OK)
+            return false; //pressure can only be written
+
+        settingsValid |= mask;
+    }
+
+    value = settings[setting];
+    return true;
 }
 
 //reads 18 bytes from sensor
-//updates global variables with read value
+//updates the cached sample with read values, the sample is only updated when the whole frame was received
+//and all six CRC bytes match
+//blocks for the read delay, see startRead() and poll() for the non-blocking version
 //see 1.4.4 in document
+//the whole read is retried according to the retry policy
 boolean SCD30::readMeasurement()
 {
-    uint32_t tempCO2 = 0;
-    uint32_t tempHumidity = 0;
-    uint32_t tempTemperature = 0;
+    SCD30_INSTRUMENT_START(start);
+    boolean success = false;
 
-    Wire.beginTransmission(SCD30_I2C_ADDRESS); //begins transmission to slave
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        if (startRead() == true)
+        {
+            delayMicroseconds(transport->getReadDelay());
 
-    //we split the 16 bit hex value int MSB and LSB
-    Wire.write(SCD30_READ_MEASUREMENT >> 8); //cmd MSB - first 8 bits of command
-    Wire.write(SCD30_READ_MEASUREMENT & 0x00FF); //cmd LSB - last 8 bits of command
+            SCD30ReadState state;
+            do
+            {
+                state = poll();
+            } while (state == SCD30_READ_PENDING);
 
-    if (Wire.endTransmission() != 0)
-        return false; //sensor did not ACK
+            if (state == SCD30_READ_DONE)
+            {
+                success = true;
+                break;
+            }
+        }
+        else if (busy() == true)
+            return false; //a non-blocking read is in progress, leave it alone
 
-    Wire.requestFrom((uint8_t)SCD30_I2C_ADDRESS, (uint8_t)18); //we're receiving an 18 byte message
+        if (retry(lastError, attempt) == false)
+            break;
+    }
 
-    if (Wire.available()) 
+    SCD30_INSTRUMENT_END(SCD30_OPERATION_MEASUREMENT, start, success == false);
+    return success;
+}
+
+//sends the read measurement command and returns right away
+//the sensor needs at least 3 ms before the 18 bytes can be read, call poll() until it returns SCD30_READ_DONE or SCD30_READ_FAILED
+//returns false if a read is already in progress or the sensor did not ACK
+//never retried, so it never waits, see readMeasurement() for a read that follows the retry policy
+//see 1.4.4 in document
+boolean SCD30::startRead()
+{
+    if (busy() == true)
+        return false;
+
+    if (record(transport->writeCommand(SCD30_READ_MEASUREMENT)) != SCD30_OK)
     {
-        for (uint8_t b = 0; b < 18; b++) 
+        readState = SCD30_READ_IDLE;
+        return false;
+    }
+
+    readStarted = micros();
+    readState = SCD30_READ_PENDING;
+    return true;
+}
+
+//a response is due for a command that was already sent, nothing else may use the sensor until it is read
+boolean SCD30::busy()
+{
+    return (readState == SCD30_READ_PENDING || readyState == SCD30_READ_PENDING || settingsState == SCD30_READ_PENDING);
+}
+
+//returns SCD30_READ_PENDING until the read delay has passed, then reads the 18 byte frame
+//SCD30_READ_DONE and SCD30_READ_FAILED are returned once, afterwards poll() returns SCD30_READ_IDLE until the next startRead()
+SCD30ReadState SCD30::poll()
+{
+    if (readState != SCD30_READ_PENDING)
+        return SCD30_READ_IDLE;
+
+    if ((uint32_t)(micros() - readStarted) < transport->getReadDelay())
+        return SCD30_READ_PENDING; //too early, the sensor is not ready to send the data
+
+    uint8_t frame[18];
+
+    readState = SCD30_READ_IDLE; //the result is reported right away
+
+    //we're receiving an 18 byte message, on a short read or a CRC mismatch the previous sample is kept
+    SCD30_INSTRUMENT_START(frameStart);
+    SCD30Error error = transport->read(frame, 18);
+    SCD30_INSTRUMENT_FRAME(frameStart, error != SCD30_OK);
+
+    if (error == SCD30_OK && decodeFrame(frame) == false)
+        error = SCD30_ERROR_CRC;
+
+    if (record(error) != SCD30_OK)
+        return SCD30_READ_FAILED; //see getLastError() for the reason
+
+    publish();
+    return SCD30_READ_DONE;
+}
+
+//same as dataAvailable(), split like startRead() and poll(), so the read delay is not waited for
+//returns false if another non-blocking job is in progress or the sensor did not ACK
+//never retried, so it never waits
+//see 1.4.4 in document
+boolean SCD30::startReadyCheck()
+{
+    if (busy() == true)
+        return false;
+
+    if (record(transport->writeCommand(SCD30_GET_READY_STATUS)) != SCD30_OK)
+        return false;
+
+    readyStarted = micros();
+    readyState = SCD30_READ_PENDING;
+    return true;
+}
+
+//returns SCD30_READ_PENDING until the read delay has passed, then reads the ready status
+//SCD30_READ_DONE if a sample is ready, SCD30_READ_FAILED if not or if the read failed, getLastError() tells which
+//both are returned once, afterwards pollReady() returns SCD30_READ_IDLE until the next startReadyCheck()
+SCD30ReadState SCD30::pollReady()
+{
+    if (readyState != SCD30_READ_PENDING)
+        return SCD30_READ_IDLE;
+
+    if ((uint32_t)(micros() - readyStarted) < transport->getReadDelay())
+        return SCD30_READ_PENDING;
+
+    uint8_t data[3];
+
+    readyState = SCD30_READ_IDLE;
+
+    SCD30Error error = transport->read(data, 3);
+
+    if (error == SCD30_OK && scd30CheckCRC8(data) == false)
+        error = SCD30_ERROR_CRC;
+
+    if (error == SCD30_OK && (data[0] != 0 || data[1] != 1))
+        error = SCD30_ERROR_NOT_READY;
+
+    SCD30_INSTRUMENT_READY(error);
+
+    return (record(error) == SCD30_OK) ? SCD30_READ_DONE : SCD30_READ_FAILED;
+}
+
+//reads the 18 byte frame straight into frame and checks the six CRC bytes, nothing is decoded and the cached sample is not touched
+//use SCD30Frame to get single fields out of it, or forward the frame as it is
+//blocks for the read delay, the whole read is retried according to the retry policy
+//returns SCD30_ERROR_NOT_READY while a non-blocking read is in progress, the frame is only valid if SCD30_OK is returned
+//see 1.4.4 in document
+SCD30Error SCD30::readRawFrame(uint8_t frame[SCD30_FRAME_SIZE])
+{
+    if (busy() == true)
+        return SCD30_ERROR_NOT_READY; //leave the non-blocking read alone
+
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        SCD30Error error = transport->writeCommand(SCD30_READ_MEASUREMENT);
+
+        if (error == SCD30_OK)
         {
-            uint8_t incoming = Wire.read();
+            delayMicroseconds(transport->getReadDelay());
 
-            switch(b) 
-            {
-                //bytes 1, 2, 4 and 5 contain CO2 data
-                case 0: 
-                case 1:
-                //byte 3 cotains CRC
-                case 3:
-                case 4:
-                    tempCO2 <<= 8;
-                    tempCO2 |= incoming;
-                    break;
-                //byte 6 cotains CRC
-                //bytes 7, 8, 10 and 11 contain temperature data
-                case 6: 
-                case 7:
-                //byte 9 contains CRC
-                case 9:
-                case 10:
-                    tempTemperature <<= 8;
-                    tempTemperature |= incoming;
-                    break;
-                //byte 12 cotains CRC
-                //bytes 13, 14, 16, 17 contain humidity data
-                case 12: 
-                case 13:
-                //byte 15 contains CRC
-                case 15:
-                case 16:
-                    tempHumidity <<= 8;
-                    tempHumidity |= incoming;
-                    break;
-                //byte 18 contains CRC
-                default:
-                    //skip all CRC bytes
-                    break;
-            }
+            SCD30_INSTRUMENT_START(frameStart);
+            error = transport->read(frame, SCD30_FRAME_SIZE);
+            SCD30_INSTRUMENT_FRAME(frameStart, error != SCD30_OK);
         }
+
+        if (error == SCD30_OK && scd30CheckFrame(frame) == false)
+            error = SCD30_ERROR_CRC;
+
+        if (record(error) == SCD30_OK)
+            return SCD30_OK;
+
+        if (retry(error, attempt) == false)
+            return error;
     }
-    
-    //copy the uint32_t CO2 values into uint16_t
-    memcpy(&co2, &tempCO2, sizeof(co2));
+}
+
+//checks the CRC bytes and decodes the 18 byte frame into the cached sample
+//every 2 data bytes are followed by their CRC, the whole frame is rejected if any of them is wrong
+boolean SCD30::decodeFrame(const uint8_t frame[])
+{
+    uint32_t tempCO2;
+    uint32_t tempHumidity;
+    uint32_t tempTemperature;
+
+    if (scd30ParseFrame(frame, tempCO2, tempTemperature, tempHumidity) == false)
+        return false;
+
+    //copy the uint32_t CO2 value into its associated float
+    memcpy(&latest.co2, &tempCO2, sizeof(latest.co2));
     //copy the uint32_t temperature and humidity into their associated floats
-    memcpy(&temperature, &tempTemperature, sizeof(temperature));
-    memcpy(&humidity, &tempHumidity, sizeof(humidity));
+    memcpy(&latest.temperature, &tempTemperature, sizeof(latest.temperature));
+    memcpy(&latest.humidity, &tempHumidity, sizeof(latest.humidity));
+
+    uint32_t previous = latest.timestamp;
+
+    if (useReadyTimestamp == true)
+        latest.timestamp = readyTimestamp; //read was triggered by RDY, see service()
+    else
+        latest.timestamp = millis();
+
+    useReadyTimestamp = false;
+    advanceSequence(previous);
 
     return true;
 }
 
+//the sensor overwrites a sample that is not read within one interval, so the time since the previous sample
+//tells how many cycles passed, every cycle beyond the first is a missed sample
+//without a known interval, or after the cycle was restarted, it counts one cycle per sample
+void SCD30::advanceSequence(uint32_t previous)
+{
+    uint32_t cycles = 1;
+    uint32_t interval = getIntervalMillis();
+
+    if (sequenceSynced == true && interval > 0)
+    {
+        cycles = (latest.timestamp - previous + interval / 2) / interval; //rounded, the polling adds jitter
+        if (cycles == 0)
+            cycles = 1;
+    }
+
+    latest.sequence += cycles;
+    missedSamples += cycles - 1;
+    sequenceSynced = true;
+}
+
+//the interval is never read from the sensor here, this is called while a sample is decoded
+uint32_t SCD30::getIntervalMillis()
+{
+    if ((settingsValid & (1 << SETTING_INTERVAL)) == 0)
+        return 0;
+
+    return (uint32_t)settings[SETTING_INTERVAL] * 1000;
+}
+
+//passes a new sample on to the attached buffer
+void SCD30::publish()
+{
+    if (buffer != NULL)
+        buffer->push(latest);
+
+    if (stats != NULL)
+        stats->add(latest);
+
+    if (deadband != NULL)
+        deadband->update(latest);
+}
+
+//every new sample is pushed into the buffer, regardless of how it was read
+//if the buffer is full the oldest sample is overwritten
+void SCD30::attachBuffer(SCD30SampleRing *buffer)
+{
+    this->buffer = buffer;
+}
+
+//every new sample is added to the statistics, regardless of how it was read
+void SCD30::attachStats(SCD30Stats *stats)
+{
+    this->stats = stats;
+}
+
+//every new sample is passed to the deadband filter, its callback then gets only the samples that changed
+void SCD30::attachDeadband(SCD30Deadband *deadband)
+{
+    this->deadband = deadband;
+}
+
+//checks if a new sample is available and reads it
+//costs one ready check and one 18 byte read, instead of a ready check per getter
+//returns false if no new sample was available, measurement is left untouched in that case
+boolean SCD30::read(Measurement &measurement)
+{
+    return (tryRead(measurement) == SCD30_OK);
+}
+
+//same as read(), but returns why no sample was read
+//SCD30_ERROR_NOT_READY means the sensor is fine, it just has no new sample yet
+SCD30Error SCD30::tryRead(Measurement &measurement)
+{
+    if (dataAvailable() == false)
+        return lastError;
+
+    if (readMeasurement() == false)
+        return lastError;
+
+    measurement = latest;
+    return SCD30_OK;
+}
+
+//checks the ready status and reads the sample right after it, as one fixed sequence:
+//ready check, read delay, read 3 bytes, read command, read delay, read 18 bytes
+//nothing is retried and nothing waits any longer, so the bus is held exactly getSampleBusTime() per sample
+//returns SCD30_ERROR_NOT_READY after only the ready check if there is no new sample, measurement is left untouched then
+SCD30Error SCD30::readIfReady(Measurement &measurement)
+{
+    if (busy() == true)
+        return SCD30_ERROR_NOT_READY; //leave the non-blocking read alone
+
+    uint16_t response = 0;
+    SCD30Error error = transferRegister(SCD30_GET_READY_STATUS, response);
+
+    if (error == SCD30_OK && response != 1)
+        error = SCD30_ERROR_NOT_READY;
+
+    SCD30_INSTRUMENT_READY(error);
+
+    if (record(error) != SCD30_OK)
+        return error;
+
+    if (startRead() == false)
+        return lastError;
+
+    delayMicroseconds(transport->getReadDelay());
+
+    SCD30ReadState state;
+    do
+    {
+        state = poll();
+    } while (state == SCD30_READ_PENDING);
+
+    if (state != SCD30_READ_DONE)
+        return lastError;
+
+    measurement = latest;
+    return SCD30_OK;
+}
+
+//returns the latest sample
+const SCD30::Measurement& SCD30::getMeasurement()
+{
+    return latest;
+}
+
+//returns the latest sample packed into 8 bytes, see SCD30_Packed.h
+//the timestamp is stored relative to referenceTime, e.g. the timestamp of the previous sample
+SCD30PackedSample SCD30::getPackedSample(uint32_t referenceTime)
+{
+    return scd30Pack(latest, referenceTime);
+}
+
+#ifndef SCD30_FIXED_POINT
+
 //returns latest available humidity
 float SCD30::getHumidity() 
 {
-    //check if new data is available to read, if not return currently saved data
-    if (dataAvailable() == true)
-        readMeasurement();
-    
-    return humidity;
+    return latest.humidity;
 }
 
 //returns latest available temperature in °C
 float SCD30::getTemperatureC()
 {
-    //check if new data is available to read, if not return currently saved data
-    if (dataAvailable() == true)
-        readMeasurement();
-    
-    return temperature;
+    return latest.temperature;
 }
 
 //returns latest available temperature in F
 float SCD30::getTemperatureF()
 {
-    //check if new data is available to read, if not return currently saved data
-    if (dataAvailable() == true)
-        readMeasurement();
-    
-    return temperature * 1.8 + 32;
+    return latest.temperature * 1.8f + 32; //float constants, so the math is not promoted to double
 }
 
 //returns latest available temperature in K
 float SCD30::getTemperatureK()
 {
-    //check if new data is available to read, if not return currently saved data
-    if (dataAvailable() == true)
-        readMeasurement();
-    
-    return temperature + 273.15;
+    return latest.temperature + 273.15f;
 }
 
+#endif
+
 //returns latest available CO2 level
 uint16_t SCD30::getCO2()
 {
-    //check if new data is available to read, if not return currently saved data
-    if (dataAvailable() == true)
-        readMeasurement();
-    
-    return co2;
+#ifdef SCD30_FIXED_POINT
+    return getCO2ppm();
+#else
+    return latest.co2;
+#endif
+}
+
+//returns the bit pattern of a float, memcpy is the portable way and compiles to a plain copy
+static uint32_t floatBits(const float &value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//returns latest available CO2 level in ppm, rounded to the nearest integer
+//uses integer operations only, see scd30FloatBitsToFixed()
+uint16_t SCD30::getCO2ppm()
+{
+    int32_t ppm = scd30FloatBitsToFixed(floatBits(latest.co2), 1);
+
+    if (ppm < 0) return 0;
+    if (ppm > UINT16_MAX) return UINT16_MAX;
+    return ppm;
+}
+
+//returns latest available temperature in 0.01 °C, e.g. 2215 is 22.15 °C
+int16_t SCD30::getTemperatureCentiC()
+{
+    int32_t centi = scd30FloatBitsToFixed(floatBits(latest.temperature), 100);
+
+    if (centi < INT16_MIN) return INT16_MIN;
+    if (centi > INT16_MAX) return INT16_MAX;
+    return centi;
+}
+
+//returns latest available humidity in 0.01 %RH, e.g. 4550 is 45.5 %RH
+uint16_t SCD30::getHumidityCentiPct()
+{
+    int32_t centi = scd30FloatBitsToFixed(floatBits(latest.humidity), 100);
+
+    if (centi < 0) return 0;
+    if (centi > UINT16_MAX) return UINT16_MAX;
+    return centi;
 }
 
 //sends a command without arguments
 boolean SCD30::sendCommand(uint16_t command)
 {
-    Wire.beginTransmission(SCD30_I2C_ADDRESS);
-    Wire.write(command >> 8); //MSB of command
-    Wire.write(command & 0x00FF); //LSB of command
+    SCD30_INSTRUMENT_START(start);
 
-    if (Wire.endTransmission() != 0)
-        return false; //sensor did not ACK
-
-    return true;
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        if (retry(record(transport->writeCommand(command)), attempt) == false)
+        {
+            SCD30_INSTRUMENT_END(SCD30_OPERATION_COMMAND, start, lastError != SCD30_OK);
+            return (lastError == SCD30_OK);
+        }
+    }
 }
 
 //sends a command with an argument
-//we need to calculate CRC on the argument
+//the transport calculates the CRC on the argument
 boolean SCD30::sendCommand(uint16_t command, uint16_t argument)
 {
-    uint8_t data[2];
-    data[0] = argument >> 8; //MSB of argument
-    data[1] = argument & 0x00FF; //LSB of argument
-    uint8_t crc = computeCRC8(data, 2); //calculate CRC on argument
-
-    Wire.beginTransmission(SCD30_I2C_ADDRESS);
-    Wire.write(command >> 8); //MSB of command
-    Wire.write(command & 0x00FF); //LSB of command
-    Wire.write(argument >> 8); //MSB of argument
-    Wire.write(argument & 0x00FF); //LSB of argument
-    Wire.write(crc); //we have to also send the CRC
-
-    if (Wire.endTransmission() != 0)
-        return false; //sensor did not ACK
+    SCD30_INSTRUMENT_START(start);
 
-    return true;
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        if (retry(record(transport->writeCommand(command, argument)), attempt) == false)
+        {
+            SCD30_INSTRUMENT_END(SCD30_OPERATION_COMMAND, start, lastError != SCD30_OK);
+            return (lastError == SCD30_OK);
+        }
+    }
 }
 
 //reads value of register
-//only used when checking if data is available
+//the response is 2 data bytes followed by their CRC, returns 0 if the read failed or the CRC does not match
+//use the other overload or getLastError() to tell a failed read from a register that is 0
 uint16_t SCD30::readRegister(uint16_t registerAddress)
 {
-    Wire.beginTransmission(SCD30_I2C_ADDRESS);
-    Wire.write(registerAddress >> 8); //MSB of register address
-    Wire.write(registerAddress & 0x00FF); //LSB of register address
+    uint16_t response = 0;
+    readRegister(registerAddress, response);
+    return response;
+}
 
-    if (Wire.endTransmission() != 0)
-        return 0; //sensor did not ACK
+//reads value of register
+//value is left untouched if the read failed
+SCD30Error SCD30::readRegister(uint16_t registerAddress, uint16_t &value)
+{
+    for (uint8_t attempt = 1; ; attempt++)
+    {
+        if (retry(record(transferRegister(registerAddress, value)), attempt) == false)
+            return lastError;
+    }
+}
 
-    Wire.requestFrom((uint8_t)SCD30_I2C_ADDRESS, (uint8_t)2); //we're receiving a 2 byte message
+//reads value of register, the result is recorded by the caller
+SCD30Error SCD30::transferRegister(uint16_t registerAddress, uint16_t &value)
+{
+    uint8_t data[3];
 
-    if (Wire.available()) 
-    {
-        uint8_t MSB = Wire.read();
-        uint8_t LSB = Wire.read();
+    SCD30_INSTRUMENT_START(start);
+    SCD30Error error = transport->writeCommand(registerAddress);
 
-        uint16_t response = MSB << 8;
-        response |= LSB;
-        return response;
+    if (error == SCD30_OK)
+    {
+        delayMicroseconds(transport->getReadDelay()); //the sensor needs some time before it can respond
+        error = transport->read(data, 3); //we're receiving a 2 byte message and its CRC
     }
 
-    else return 0;
+    if (error == SCD30_OK && scd30CheckCRC8(data) == false)
+        error = SCD30_ERROR_CRC; //corrupted on the bus
 
+    SCD30_INSTRUMENT_END(SCD30_OPERATION_REGISTER, start, error != SCD30_OK);
+
+    if (error != SCD30_OK)
+        return error;
+
+    value = data[0] << 8;
+    value |= data[1];
+    return SCD30_OK;
 }
 
-//calculates crc on the arguments being sent
-//we do not need to compute crc on the command
-//polynomial is: x^8+x^5+x^4+1 = 0x31
-//from: http://www.sunshine2k.de/articles/coding/crc/understanding_crc.html
-uint8_t SCD30::computeCRC8(uint8_t data[], uint8_t len)
+//remembers the result of a transaction and counts it
+//returns the error, so it can be used in a return statement
+SCD30Error SCD30::record(SCD30Error error)
 {
-    uint8_t crc = 0x00FF; //initialize with 0xFF
-    uint16_t generator = 0x0031;
+    lastError = error;
+    errorCounters.counts[error]++;
+    return error;
+}
 
-    for (uint8_t x = 0 ; x < len ; x++)
+//decides if a failed transaction is tried again
+//not ready is an answer and not an error, it is never retried
+//after a timeout or a bus error the transport first tries to free the bus
+//the wait before every retry starts at initialBackoff and doubles up to maxBackoff,
+//so a sensor that is gone costs at most maxAttempts bounded transactions and their backoff
+boolean SCD30::retry(SCD30Error error, uint8_t attempt)
+{
+    if (error == SCD30_OK || error == SCD30_ERROR_NOT_READY || attempt >= retryPolicy.maxAttempts)
+        return false;
+
+    if (error == SCD30_ERROR_TIMEOUT || error == SCD30_ERROR_BUS)
     {
-        crc ^= data[x]; //XOR-in the next input byte
-
-        //crc on one byte data
-        for (uint8_t i = 0 ; i < 8 ; i++)
-        { 
-            if ((crc & 0x80) != 0)
-                crc = (uint8_t)((crc << 1) ^ generator);
-            else
-                crc <<= 1; //most significant bit is not 1, shift left
-        }
+        if (transport->recover() == true)
+            recoveries++;
     }
 
-    return crc;
+    uint32_t backoff = retryPolicy.maxBackoff;
+    if (attempt <= 16)
+        backoff = (uint32_t)retryPolicy.initialBackoff << (attempt - 1);
+    if (backoff > retryPolicy.maxBackoff)
+        backoff = retryPolicy.maxBackoff;
+
+    delay(backoff);
+    return true;
+}
+
+//sets how failed transactions are retried, by default they are not
+//applies to sendCommand(), readRegister(), dataAvailable() and readMeasurement(), but not to the non-blocking startRead()/poll()
+void SCD30::setRetryPolicy(const SCD30RetryPolicy &policy)
+{
+    retryPolicy = policy;
+}
+
+//sets the timeout of every transaction on the bus in us, 0 leaves the platform default
+//only applies to the built in Wire transport, configure other transports directly
+void SCD30::setBusTimeout(uint32_t timeout)
+{
+    wireTransport.setTimeout(timeout);
+}
+
+//sets the SDA and SCL pins used to free a stuck bus, by default SDA and SCL of the board
+void SCD30::setBusPins(uint8_t sdaPin, uint8_t sclPin)
+{
+    wireTransport.setBusPins(sdaPin, sclPin);
+}
+
+//returns number of times the bus was freed with a recovery after a timeout or bus error
+uint32_t SCD30::getRecoveries()
+{
+    return recoveries;
+}
+
+//returns the result of the last transaction
+SCD30Error SCD30::getLastError()
+{
+    return lastError;
+}
+
+//returns the number of transactions per result
+//e.g. getErrorCounters().counts[SCD30_ERROR_CRC] is the number of corrupted responses
+const SCD30ErrorCounters& SCD30::getErrorCounters()
+{
+    return errorCounters;
+}
+
+void SCD30::resetErrorCounters()
+{
+    memset(&errorCounters, 0, sizeof(errorCounters));
+}
+
+//returns the bus the sensor is on
+TwoWire& SCD30::getWire()
+{
+    return wireTransport.getWire();
+}
+
+//returns how many samples the sensor overwrote before they were read, inferred from the gaps between samples
+//if this grows, poll more often or drain the buffer faster
+uint32_t SCD30::getMissedSamples()
+{
+    return missedSamples;
+}
+
+void SCD30::resetMissedSamples()
+{
+    missedSamples = 0;
+}
+
+//returns the transport the driver uses
+SCD30Transport& SCD30::getTransport()
+{
+    return *transport;
+}
+
+//returns how long one sample (ready check and read) holds the bus, in us
+//the bus is free during the two read delays, so this is what sizes how many sensors can share it
+//a multiplexer adds one more 2 byte write when it has to switch the channel
+uint32_t SCD30::getSampleBusTime()
+{
+    return (uint32_t)((uint64_t)SCD30_SAMPLE_BUS_CLOCKS * 1000000 / transport->getClock());
+}
+
+//the stats count from here on, the caller keeps them and reads them directly
+//does nothing with SCD30_NO_INSTRUMENTATION
+void SCD30::attachInstrumentation(SCD30DriverStats *stats)
+{
+#ifndef SCD30_NO_INSTRUMENTATION
+    driverStats = stats;
+#else
+    (void)stats;
+#endif
+}
+
+//prints the timing of all bus operations, e.g. printStats(Serial)
+void SCD30::printStats(Stream &stream)
+{
+    if (driverStats != NULL)
+        scd30PrintStats(stream, *driverStats);
+}
+
+void SCD30::resetStats()
+{
+    if (driverStats != NULL)
+        *driverStats = SCD30DriverStats();
+}
+
+//times one frame read, what the 18 bytes and the address do not explain at the bus clock is clock stretching
+void SCD30::instrumentFrame(uint32_t time, boolean failed)
+{
+    scd30RecordOperation(*driverStats, SCD30_OPERATION_FRAME, time, failed);
+
+    if (failed == false)
+        scd30RecordStretch(*driverStats, time, (uint32_t)((uint64_t)((SCD30_FRAME_SIZE + 1) * 9 + 2) * 1000000 / transport->getClock()));
+}
+
+//calculates crc on the arguments being sent and on received data
+//we do not need to compute crc on the command
+//polynomial is: x^8+x^5+x^4+1 = 0x31, see SCD30_CRC.h
+uint8_t SCD30::computeCRC8(const uint8_t data[], uint8_t len)
+{
+    return scd30ComputeCRC8(data, len);
 }
 
 //gets current firmware version, formatted as [Major, Minor]
@@ -403,14 +1237,224 @@ uint8_t* SCD30::getFirmwareVersion()
 
 //soft resets the sensor
 //see 1.4.9 in document
+//all cached settings are forgotten, they are read from the sensor again after the reset
 boolean SCD30::softReset()
 {
+    settingsValid = 0;
+    sequenceSynced = false;
     return(sendCommand(SCD30_SOFT_RESET));
 }
 
 //used to attach interrupt from RDY pin of SCD30, parameters are the pin on the MCU and a function
-//see attached interruptExample example
+//the function is called from interrupt context, it must not use I2C, see attachReadyInterrupt() for that
 void SCD30::attachExternalInterrupt(uint8_t pin, void(*function)(void)) 
 {
-    attachInterrupt(digitalPinToInterrupt(pin), function, HIGH);    //when a new measurement is ready the value of RDY is 1 (high)
-}
\ No newline at end of file
+    attachInterrupt(digitalPinToInterrupt(pin), function, RISING);    //when a new measurement is ready RDY goes from 0 to 1 (high) until the sample is read
+}
+
+//attaches the built in interrupt to the RDY pin of SCD30
+//the interrupt only latches a flag and the time, service() then reads the sample outside of interrupt context and calls the callback
+//callback can be NULL, the sample is then only cached
+//returns false if all SCD30_MAX_INTERRUPTS slots are taken
+//see attached interruptExample example
+boolean SCD30::attachReadyInterrupt(uint8_t pin, SCD30MeasurementCallback callback)
+{
+    static void (* const isrs[SCD30_MAX_INTERRUPTS])(void) = { readyISR0, readyISR1, readyISR2, readyISR3 };
+
+    detachReadyInterrupt();
+
+    for (uint8_t i = 0; i < SCD30_MAX_INTERRUPTS; i++)
+    {
+        if (interruptInstances[i] == NULL)
+        {
+            interruptInstances[i] = this;
+            interruptSlot = i;
+            interruptPin = pin;
+            measurementCallback = callback;
+
+            pinMode(pin, INPUT);
+            attachInterrupt(digitalPinToInterrupt(pin), isrs[i], RISING); //RDY goes high when a new sample is ready and stays high until it is read
+
+            //if a sample is already waiting RDY is high and we would never see the rising edge
+            if (digitalRead(pin) == HIGH)
+            {
+                readyMicros = micros();
+                readyFlag = true;
+            }
+
+            return true;
+        }
+    }
+
+    return false; //no free slot
+}
+
+//detaches the built in RDY interrupt
+void SCD30::detachReadyInterrupt()
+{
+    if (interruptSlot < 0)
+        return;
+
+    detachInterrupt(digitalPinToInterrupt(interruptPin));
+    interruptInstances[interruptSlot] = NULL;
+    interruptSlot = -1;
+    readyFlag = false;
+}
+
+//reads the sample flagged by the RDY interrupt and passes it to the callback
+//call it from loop(), the I2C transfer happens here and not in the interrupt
+//the timestamp of the sample is the time RDY went high
+//returns true if a new sample was read
+boolean SCD30::service()
+{
+    if (readyFlag == false)
+        return false;
+
+    noInterrupts();
+    uint32_t stamp = readyMicros;
+    readyFlag = false;
+    interrupts();
+
+    latchReady(stamp);
+
+    if (readMeasurement() == false)
+    {
+        useReadyTimestamp = false;
+        return false;
+    }
+
+    if (measurementCallback != NULL)
+        measurementCallback(latest);
+
+    return true;
+}
+
+//back dates the next sample to stamp, the micros() when RDY went high
+//RDY stays high until the sample is read, so if that took longer than one interval the sensor has overwritten
+//the sample meanwhile without a new edge, the sample is then only as old as the time since the last cycle
+void SCD30::latchReady(uint32_t stamp)
+{
+    uint32_t age = (uint32_t)(micros() - stamp) / 1000;
+    uint32_t interval = getIntervalMillis();
+
+    if (interval > 0 && age >= interval)
+        age %= interval;
+
+    readyTimestamp = millis() - age;
+    useReadyTimestamp = true;
+}
+
+//puts the MCU to sleep until the next sample is ready and reads it
+//with SCD30_WAKE_READY the RDY pin wakes the MCU, attachReadyInterrupt() has to be called first, otherwise the timer is used
+//with SCD30_WAKE_TIMER the MCU sleeps until one measurement interval after the last sample
+//the bus is restarted after sleeping, the sample is also passed to an attached buffer
+//returns false if no sample was read, e.g. RDY never came
+//see attached lowPowerExample example
+boolean SCD30::sleepUntilReady(Measurement &measurement)
+{
+    uint32_t period = (uint32_t)getMeasurementInterval() * 1000; //answered from the settings cache
+    if (period == 0)
+        period = 2000;
+
+    SCD30WakeSource source = wakeSource;
+    if (source == SCD30_WAKE_READY && interruptSlot < 0)
+        source = SCD30_WAKE_TIMER; //no RDY pin known
+
+    uint32_t start = millis();
+    uint32_t sleepTime = 2 * period; //RDY comes within one period, do not sleep forever if the sensor stopped
+
+    if (source == SCD30_WAKE_TIMER)
+    {
+        uint32_t sinceLast = start - latest.timestamp;
+        sleepTime = (latest.sequence > 0 && sinceLast < period) ? period - sinceLast : 0;
+    }
+
+    boolean slept = false;
+
+    while (readyFlag == false)
+    {
+        if (source == SCD30_WAKE_READY && digitalRead(interruptPin) == HIGH)
+            break; //the edge can be missed while the core sleeps
+
+        uint32_t elapsed = millis() - start;
+        if (elapsed >= sleepTime)
+            break;
+
+        if (sleepHook == NULL)
+        {
+            delay((source == SCD30_WAKE_READY) ? 1 : sleepTime - elapsed); //no sleep function set, just waits
+            continue;
+        }
+
+        sleepHook(source, interruptPin, sleepTime - elapsed);
+        slept = true;
+    }
+
+    if (slept == true)
+        transport->begin(); //the bus may have lost its state while sleeping
+
+    boolean ready = false;
+
+    if (source == SCD30_WAKE_READY && (readyFlag == true || digitalRead(interruptPin) == HIGH))
+    {
+        noInterrupts();
+        uint32_t stamp = (readyFlag == true) ? readyMicros : micros();
+        readyFlag = false;
+        interrupts();
+
+        latchReady(stamp);
+        ready = true;
+    }
+
+    //before the first sample it is not known when the sensor is due, so a whole period is waited
+    uint32_t slack = (latest.sequence > 0) ? SCD30_WAKE_SLACK : period + SCD30_WAKE_SLACK;
+
+    if (ready == false && waitForData(slack) == false)
+        return false;
+
+    if (readMeasurement() == false)
+    {
+        useReadyTimestamp = false;
+        return false;
+    }
+
+    measurement = latest;
+    return true;
+}
+
+void SCD30::setWakeSource(SCD30WakeSource source)
+{
+    wakeSource = source;
+}
+
+void SCD30::setSleepHook(SCD30SleepHook hook)
+{
+    sleepHook = hook;
+}
+
+//called from the interrupt, only latches the flag and the time
+void SCD30_ISR_ATTR SCD30::handleReady()
+{
+    readyMicros = micros();
+    readyFlag = true;
+}
+
+void SCD30_ISR_ATTR SCD30::readyISR0()
+{
+    interruptInstances[0]->handleReady();
+}
+
+void SCD30_ISR_ATTR SCD30::readyISR1()
+{
+    interruptInstances[1]->handleReady();
+}
+
+void SCD30_ISR_ATTR SCD30::readyISR2()
+{
+    interruptInstances[2]->handleReady();
+}
+
+void SCD30_ISR_ATTR SCD30::readyISR3()
+{
+    interruptInstances[3]->handleReady();
+}
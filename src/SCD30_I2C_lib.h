@@ -29,7 +29,22 @@ https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.
 
 #include <Wire.h>
 
-#define SCD30_I2C_ADDRESS 0x61 //default SCD30 I2C address
+//define SCD30_FIXED_POINT to leave out the float getters, so that sketches using only the integer getters
+//do not pull in float math, getCO2() then also uses the integer path
+//it has to be defined for the whole build (e.g. -DSCD30_FIXED_POINT), or uncomment the line below
+//#define SCD30_FIXED_POINT
+
+//define SCD30_NO_INSTRUMENTATION to leave out the timing of bus operations, see SCD30_Instrumentation.h
+//the class stays the same, attachInstrumentation() then does nothing
+//#define SCD30_NO_INSTRUMENTATION
+
+#include "SCD30_CRC.h"
+#include "SCD30_Mux.h"
+#include "SCD30_Transport.h"
+#include "SCD30_Packed.h"
+#include "SCD30_Sleep.h"
+#include "SCD30_Frame.h"
+#include "SCD30_Instrumentation.h"
 
 //defines for available commands
 #define SCD30_START_CONTINUOUS_MEASUREMENT 0x0010
@@ -44,18 +59,107 @@ https://www.sensirion.com/fileadmin/user_upload/customers/sensirion/Dokumente/9.
 #define SCD30_READ_FIRMWARE_VERSION 0xD100
 #define SCD30_SOFT_RESET 0xD304
 
+#define SCD30_BOOT_TIMEOUT 2000 //ms applyConfig() waits for the sensor to answer, e.g. after softReset()
+#define SCD30_BACKOFF_START 10 //ms between the first readiness checks
+#define SCD30_BACKOFF_MAX 500 //ms between readiness checks at most, the wait doubles after every check
+
+#define SCD30_MAX_INTERRUPTS 4 //number of sensors that can use the built in RDY interrupt at the same time
+
+//interrupt service routines on ESP32 and ESP8266 have to be in IRAM
+#if defined(ESP32) || defined(ESP8266)
+    #define SCD30_ISR_ATTR IRAM_ATTR
+#else
+    #define SCD30_ISR_ATTR
+#endif
+
+//how begin() treats a sensor that is already measuring
+enum SCD30BeginMode
+{
+    SCD30_COLD_START, //always (re)starts the measurements
+    SCD30_WARM_START //leaves the sensor alone if it already measures with the wanted settings
+};
+
+//states of the non-blocking read, see startRead() and poll()
+enum SCD30ReadState
+{
+    SCD30_READ_IDLE, //no read in progress
+    SCD30_READ_PENDING, //command was sent, waiting for the read delay to pass
+    SCD30_READ_DONE, //a new sample was read, returned once by poll()
+    SCD30_READ_FAILED //the read failed and the previous sample is kept, returned once by poll()
+};
+
+//one complete sample, all values are taken from the same 18 byte read
+struct SCD30Measurement
+{
+    float co2; //CO2 concentration in ppm
+    float temperature; //temperature in °C
+    float humidity; //relative humidity in %RH
+    uint32_t timestamp; //millis() when the sample was read, or when RDY went high if read through the RDY interrupt
+    uint32_t sequence; //measurement cycle of the sensor, inferred from the interval, a gap of more than 1 means samples were missed
+};
+
+//settings applied together by applyConfig()
+struct SCD30Config
+{
+    uint16_t measurementInterval = 2; //s, 2 to 1800
+    boolean automaticSelfCalibration = false;
+    uint16_t temperatureOffset = 0; //0.01 °C
+    uint16_t altitude = 0; //m above sea level
+    uint16_t ambientPressure = 0; //mBar, 700 to 1200, 0 deactivates pressure compensation
+};
+
+//every setting the sensor can report, see readAllSettings()
+struct SCD30Settings
+{
+    uint16_t measurementInterval; //s
+    boolean automaticSelfCalibration;
+    uint16_t forcedRecalibrationValue; //ppm
+    uint16_t temperatureOffset; //0.01 °C
+    uint16_t altitude; //m above sea level
+    uint8_t firmwareVersion[2]; //major, minor
+};
+
+#define SCD30_SETTINGS_STEPS 6 //registers read by readAllSettings()
+
+//number of transactions per result, counts[SCD30_OK] are the successful ones
+struct SCD30ErrorCounters
+{
+    uint32_t counts[SCD30_ERROR_COUNT];
+};
+
+//how failed transactions are retried, see setRetryPolicy()
+struct SCD30RetryPolicy
+{
+    uint8_t maxAttempts = 1; //attempts per transaction, 1 does not retry
+    uint16_t initialBackoff = 2; //ms before the first retry
+    uint16_t maxBackoff = 50; //ms between retries at most, the wait doubles after every retry
+};
+
+class SCD30SampleRing;
+class SCD30Stats;
+class SCD30Deadband;
+
+typedef void (*SCD30MeasurementCallback)(const SCD30Measurement &measurement); //called by service() with every new sample
+
 class SCD30 
 {
     public:
-        SCD30(); //constructor
+        typedef SCD30Measurement Measurement;
+
+        SCD30(TwoWire &wirePort = Wire); //constructor, sensor directly on the bus
+        SCD30(SCD30Mux &mux, uint8_t muxChannel); //constructor, sensor behind a channel of an I2C multiplexer
+        SCD30(SCD30Transport &transport); //constructor, sensor reached through another transport, e.g. SCD30MockTransport
         ~SCD30(); //destructor
 
-        boolean begin(); //initialize library instance
+        boolean begin(uint32_t clockSpeed = SCD30_I2C_MAX_CLOCK); //initialize library instance, clockSpeed of the bus in Hz, at most 100 kHz
+        boolean begin(SCD30BeginMode mode, uint32_t clockSpeed = SCD30_I2C_MAX_CLOCK); //same, SCD30_WARM_START keeps a sensor measuring that already is
+        boolean begin(const SCD30Config &config, SCD30BeginMode mode = SCD30_COLD_START, uint32_t clockSpeed = SCD30_I2C_MAX_CLOCK); //same, then applies config
 
         boolean beginMeasuring(void); //starts the measurements, with the default interval of 2s
         boolean beginMeasuring(uint16_t ambientPressureOffset); //starts the measurements with ambient pressure copensation in mBar, 
                                                                 //if argument is 0, pressure compensation is deactivated
         boolean stopMeasuring(); //stops the measurements
+        boolean resumeMeasuring(); //starts the measurements again after stopMeasuring(), with the ambient pressure set last
 
         boolean dataAvailable(); //checks if data is available
 
@@ -74,20 +178,51 @@ class SCD30
         uint16_t getTemperatureOffset(); //gets set temperature offset
         uint16_t getAltitudeCompensation(); //gets set altitute compensation value
 
+        boolean refresh(); //reads all settings from the sensor again, the getters above are answered from a cache
+
+        SCD30Error readAllSettings(SCD30Settings &settings); //reads every setting and the firmware version from the sensor, CRC checked
+        boolean startReadSettings(); //starts the same as a non-blocking job
+        SCD30ReadState pollSettings(SCD30Settings &settings); //does at most one transaction of the job, settings is filled once it returns SCD30_READ_DONE
+
+        boolean applyConfig(const SCD30Config &config); //writes the settings that differ from the sensor and (re)starts measuring if needed
+        boolean waitForFirmware(uint32_t timeout); //waits until the sensor answers, e.g. after softReset(), timeout in ms
+        boolean waitForData(uint32_t timeout); //waits until a sample is available, timeout in ms
+
         boolean readMeasurement(); //reads 18 byte measurement
+        boolean read(Measurement &measurement); //checks if data is available and reads it, one ready check and one 18 byte read
+        SCD30Error tryRead(Measurement &measurement); //same as read(), but tells why no sample was read
+        SCD30Error readIfReady(Measurement &measurement); //ready check and read back to back in a fixed sequence, never retried
+
+        boolean startRead(); //sends the read measurement command and returns without waiting for the data
+        SCD30ReadState poll(); //finishes a read started with startRead() once the read delay has passed
+        boolean startReadyCheck(); //sends the ready status command and returns without waiting for the response
+        SCD30ReadState pollReady(); //finishes a check started with startReadyCheck(), SCD30_READ_DONE if a sample is ready
+        SCD30Error readRawFrame(uint8_t frame[SCD30_FRAME_SIZE]); //reads the 18 byte frame into frame and checks the CRCs, nothing is decoded
 
+        SCD30PackedSample getPackedSample(uint32_t referenceTime); //gets the latest sample in the 8 byte format, timestamp relative to referenceTime
+
+        //the getters below only return the latest sample, call read() or readMeasurement() to fetch a new one
+        const Measurement& getMeasurement(); //gets the latest sample
+#ifndef SCD30_FIXED_POINT
         float getHumidity(); //gets humidity in %RH
         float getTemperatureC(); //gets temperature in °C
         float getTemperatureF(); //gets temperature in F
         float getTemperatureK(); //gets temperature in K
+#endif
         uint16_t getCO2(); //gets CO2 concentration in ppm
 
+        //integer getters, decoded straight from the IEEE-754 bit patterns without any float math
+        uint16_t getCO2ppm(); //gets CO2 concentration in ppm, rounded
+        int16_t getTemperatureCentiC(); //gets temperature in 0.01 °C
+        uint16_t getHumidityCentiPct(); //gets humidity in 0.01 %RH
+
         boolean sendCommand(uint16_t command); //sends command via I2C
         boolean sendCommand(uint16_t command, uint16_t argument); //sends command via I2C, with an additional argument
 
-        uint16_t readRegister(uint16_t registerAddress); //reads specified register
+        uint16_t readRegister(uint16_t registerAddress); //reads specified register, 0 if the read failed, see getLastError()
+        SCD30Error readRegister(uint16_t registerAddress, uint16_t &value); //reads specified register, value is only set on success
 
-        uint8_t computeCRC8(uint8_t data[], uint8_t len); //calculates crc checksum
+        uint8_t computeCRC8(const uint8_t data[], uint8_t len); //calculates crc checksum
 
         uint8_t* getFirmwareVersion(); //gets the firmware version in format major.minor
 
@@ -95,13 +230,126 @@ class SCD30
 
         void attachExternalInterrupt(uint8_t pin, void (*function)(void)); //attaches interrupt to pin
 
+        boolean attachReadyInterrupt(uint8_t pin, SCD30MeasurementCallback callback); //attaches the built in RDY interrupt, callback is called from service()
+        void detachReadyInterrupt(); //detaches the built in RDY interrupt
+        boolean service(); //reads the sample flagged by the RDY interrupt and passes it to the callback, call from loop()
+
+        boolean sleepUntilReady(Measurement &measurement); //sleeps until the next sample is ready and reads it
+        void setWakeSource(SCD30WakeSource source); //sets what wakes sleepUntilReady(), RDY needs attachReadyInterrupt()
+        void setSleepHook(SCD30SleepHook hook); //sets the function that puts the MCU to sleep, e.g. scd30Sleep, NULL only waits
+
+        void attachBuffer(SCD30SampleRing *buffer); //every new sample is pushed into buffer, NULL detaches it
+        void attachStats(SCD30Stats *stats); //every new sample is added to stats, NULL detaches it
+        void attachDeadband(SCD30Deadband *deadband); //every new sample is passed to deadband, NULL detaches it
+
+        void setRetryPolicy(const SCD30RetryPolicy &policy); //sets how failed transactions are retried
+        void setBusTimeout(uint32_t timeout); //sets the timeout of every transaction in us, 0 leaves the platform default
+        void setBusPins(uint8_t sdaPin, uint8_t sclPin); //sets the pins used to free a stuck bus
+        uint32_t getRecoveries(); //gets number of times the bus had to be recovered
+
+        SCD30Error getLastError(); //gets the result of the last transaction
+        const SCD30ErrorCounters& getErrorCounters(); //gets the number of transactions per result
+        void resetErrorCounters(); //sets all counters to 0
+
+        uint32_t getMissedSamples(); //gets number of samples the sensor overwrote before they were read
+        void resetMissedSamples(); //sets the counter to 0
+
+        TwoWire& getWire(); //gets the bus the sensor is on
+        SCD30Transport& getTransport(); //gets the transport the driver uses
+        uint32_t getSampleBusTime(); //gets us one sample holds the bus at the current clock
+
+        void attachInstrumentation(SCD30DriverStats *stats); //times every bus operation into stats, NULL detaches it
+        void printStats(Stream &stream); //prints the attached stats, e.g. printStats(Serial)
+        void resetStats(); //sets all attached stats to 0
+
     private:
-        //measured values
-        float co2 = 0;
-        float temperature = 0;
-        float humidity = 0;
+        //settings that are cached, see writeSetting() and readSetting()
+        enum Setting
+        {
+            SETTING_INTERVAL,
+            SETTING_ASC,
+            SETTING_FRC,
+            SETTING_TEMPERATURE_OFFSET,
+            SETTING_ALTITUDE,
+            SETTING_PRESSURE, //can only be written, with the start continuous measurement command
+            SETTING_COUNT
+        };
+
+        boolean writeSetting(Setting setting, uint16_t value, boolean force); //writes a setting unless the cache says it is already set
+        boolean canResume(const SCD30Config &config, boolean all); //checks if the sensor already measures with config, see begin()
+        boolean updateSetting(Setting setting, uint16_t value); //reads a setting first (or takes it from the cache) and writes it only if it differs
+        boolean readSetting(Setting setting, uint16_t &value); //reads a setting from the cache, or from the sensor if it is not cached
+        SCD30Error transferRegister(uint16_t registerAddress, uint16_t &value); //reads specified register without recording the result
+        SCD30Error record(SCD30Error error); //remembers the result of a transaction and counts it
+        boolean retry(SCD30Error error, uint8_t attempt); //waits and recovers the bus if needed, returns false if the transaction should not be retried
+
+        boolean decodeFrame(const uint8_t frame[]); //checks CRC and decodes the 18 byte frame into the cached sample
+        void publish(); //passes a new sample on to the attached buffer, stats and deadband
+
+        //errors
+        SCD30Error lastError = SCD30_OK;
+        SCD30ErrorCounters errorCounters = {};
+        SCD30RetryPolicy retryPolicy;
+        uint32_t recoveries = 0;
+
+        //shadow copies of the sensor settings
+        static const uint16_t settingCommands[SETTING_COUNT];
+        uint16_t settings[SETTING_COUNT] = {};
+        uint8_t settingsValid = 0; //one bit per setting, set when the shadow copy matches the sensor
+
+        //bus
+        SCD30WireTransport wireTransport; //used unless another transport is passed to the constructor
+        SCD30Transport *transport;
+
+        //latest measured values
+        Measurement latest = {};
+        void advanceSequence(uint32_t previous); //infers the cycles passed since the sample read at previous
+        uint32_t getIntervalMillis(); //gets the measurement interval in ms from the cache, 0 if it is not known
+        boolean sequenceSynced = false; //false until the first sample of the current measurement cycle is read
+        uint32_t missedSamples = 0;
+        SCD30SampleRing *buffer = NULL;
+        SCD30Stats *stats = NULL;
+        SCD30Deadband *deadband = NULL;
+
+        //RDY interrupt, the interrupt only sets the flag, the read is done in service()
+        void handleReady(); //called from the interrupt
+        static void readyISR0();
+        static void readyISR1();
+        static void readyISR2();
+        static void readyISR3();
+        static SCD30* interruptInstances[SCD30_MAX_INTERRUPTS];
+
+        volatile boolean readyFlag = false;
+        volatile uint32_t readyMicros = 0; //micros() when RDY went high
+        uint32_t readyTimestamp = 0; //millis() when RDY went high, used as timestamp of the next sample
+        boolean useReadyTimestamp = false;
+        int8_t interruptSlot = -1;
+        uint8_t interruptPin = 0;
+        SCD30MeasurementCallback measurementCallback = NULL;
+        void latchReady(uint32_t stamp); //uses the time RDY went high as timestamp of the next read
+
+        //low power
+        SCD30WakeSource wakeSource = SCD30_WAKE_READY;
+        SCD30SleepHook sleepHook = NULL; //waits without sleeping, so scd30Sleep() is only linked if a sketch uses it
+
+        //non-blocking read
+        SCD30ReadState readState = SCD30_READ_IDLE;
+        uint32_t readStarted = 0; //micros() when the read command was sent
+        SCD30ReadState readyState = SCD30_READ_IDLE; //non-blocking ready check, see startReadyCheck()
+        uint32_t readyStarted = 0; //micros() when the ready status command was sent
+        boolean busy(); //true while a non-blocking read, ready check or settings job waits for the sensor to respond
+
+        //non-blocking settings job, see startReadSettings()
+        SCD30ReadState settingsState = SCD30_READ_IDLE;
+        uint8_t settingsStep = 0; //register being read
+        boolean settingsWritten = false; //command of the step was sent, its response is due
+        uint32_t settingsStarted = 0; //micros() when the command was sent
+        uint16_t settingsValues[SCD30_SETTINGS_STEPS];
         
         uint8_t firmwareVersion[2];
+
+        SCD30DriverStats *driverStats = NULL; //see attachInstrumentation()
+        void instrumentFrame(uint32_t time, boolean failed); //adds a frame read and its clock stretching
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+/*
+Optional instrumentation of the SCD30 driver.
+See SCD30_Instrumentation.h for details.
+*/
+
+#include "SCD30_Instrumentation.h"
+
+//returns a short name of the operation, e.g. for logging
+const char* scd30OperationToString(SCD30Operation operation)
+{
+    switch (operation)
+    {
+        case SCD30_OPERATION_COMMAND: return "command";
+        case SCD30_OPERATION_REGISTER: return "register";
+        case SCD30_OPERATION_MEASUREMENT: return "measurement";
+        case SCD30_OPERATION_FRAME: return "frame";
+        default: return "unknown";
+    }
+}
+
+//adds one timed operation, a bucket is found with shifts only
+void scd30RecordOperation(SCD30DriverStats &stats, SCD30Operation operation, uint32_t time, bool failed)
+{
+    SCD30OperationStats &op = stats.operations[operation];
+
+    if (op.calls == 0 || time < op.minTime)
+        op.minTime = time;
+    if (time > op.maxTime)
+        op.maxTime = time;
+
+    op.calls++;
+    op.totalTime += time;
+
+    if (failed == true)
+        op.failures++;
+
+    uint8_t bucket = 0;
+    for (uint32_t bound = SCD30_HISTOGRAM_FIRST; time >= bound && bucket < SCD30_HISTOGRAM_BUCKETS - 1; bound <<= 1)
+        bucket++;
+
+    op.histogram[bucket]++;
+}
+
+//a ready check that failed on the bus did not tell anything about the sensor, it is not counted
+void scd30RecordReady(SCD30DriverStats &stats, SCD30Error error)
+{
+    if (error != SCD30_OK && error != SCD30_ERROR_NOT_READY)
+        return;
+
+    stats.readyChecks++;
+    if (error == SCD30_ERROR_NOT_READY)
+        stats.notReady++;
+}
+
+//the part of a frame read that the bytes alone do not explain is taken as clock stretching by the sensor
+void scd30RecordStretch(SCD30DriverStats &stats, uint32_t time, uint32_t expected)
+{
+    uint32_t stretch = (time > expected) ? time - expected : 0;
+
+    stats.stretchTime += stretch;
+    if (stretch > stats.maxStretch)
+        stats.maxStretch = stretch;
+}
+
+//prints one line per operation, its histogram, the not ready ratio and the clock stretching
+//integer operations only, so it also fits sketches built with SCD30_FIXED_POINT
+void scd30PrintStats(Stream &stream, const SCD30DriverStats &stats)
+{
+    for (uint8_t i = 0; i < SCD30_OPERATION_COUNT; i++)
+    {
+        const SCD30OperationStats &op = stats.operations[i];
+
+        stream.print(scd30OperationToString((SCD30Operation)i));
+        stream.print(" calls:");
+        stream.print(op.calls);
+        stream.print(" failed:");
+        stream.print(op.failures);
+        stream.print(" min/avg/max(us):");
+        stream.print(op.minTime);
+        stream.print("/");
+        stream.print((uint32_t)((op.calls > 0) ? op.totalTime / op.calls : 0));
+        stream.print("/");
+        stream.print(op.maxTime);
+        stream.println();
+
+        stream.print("  histogram(us):");
+        for (uint8_t b = 0; b < SCD30_HISTOGRAM_BUCKETS; b++)
+        {
+            if (op.histogram[b] == 0)
+                continue;
+
+            stream.print((b < SCD30_HISTOGRAM_BUCKETS - 1) ? " <" : " >=");
+            stream.print((uint32_t)SCD30_HISTOGRAM_FIRST << ((b < SCD30_HISTOGRAM_BUCKETS - 1) ? b : b - 1));
+            stream.print(":");
+            stream.print(op.histogram[b]);
+        }
+        stream.println();
+    }
+
+    //not ready ratio in 0.1 %
+    uint32_t permille = (stats.readyChecks > 0) ? (uint32_t)((uint64_t)stats.notReady * 1000 / stats.readyChecks) : 0;
+
+    stream.print("ready checks:");
+    stream.print(stats.readyChecks);
+    stream.print(" not ready:");
+    stream.print(stats.notReady);
+    stream.print(" (");
+    stream.print(permille / 10);
+    stream.print(".");
+    stream.print(permille % 10);
+    stream.print("%)");
+    stream.println();
+
+    stream.print("clock stretch total/max(us):");
+    stream.print((uint32_t)stats.stretchTime);
+    stream.print("/");
+    stream.print(stats.maxStretch);
+    stream.println();
+}
@@ -0,0 +1,82 @@
+/*
+Optional instrumentation of the SCD30 driver.
+
+Pass a SCD30DriverStats to SCD30::attachInstrumentation() to have the driver time every command, register read
+and measurement read with micros(). Without one attached each bus operation only checks a pointer.
+Define SCD30_NO_INSTRUMENTATION for the whole build (e.g. -DSCD30_NO_INSTRUMENTATION) to leave the timing code out,
+attachInstrumentation() then does nothing. The SCD30 class is the same with or without the define.
+
+Per operation it keeps the number of calls and failures, min/avg/max time and a histogram with power of two buckets,
+starting below SCD30_HISTOGRAM_FIRST us. It also counts how many ready checks found no new sample and
+estimates how long the sensor stretched the clock while sending a measurement.
+*/
+
+#ifndef SCD30_Instrumentation_h
+#define SCD30_Instrumentation_h
+
+#if (ARDUINO >= 100)
+    #include "Arduino.h"
+#else
+    #include "WProgram.h"
+#endif
+
+#include "SCD30_Transport.h"
+
+#define SCD30_HISTOGRAM_BUCKETS 12 //<64, <128, ... <65536 us and everything above
+#define SCD30_HISTOGRAM_FIRST 64 //us, upper bound of the first bucket
+
+//what was timed
+enum SCD30Operation
+{
+    SCD30_OPERATION_COMMAND, //sendCommand(), including retries
+    SCD30_OPERATION_REGISTER, //one register read, including the read delay, e.g. by dataAvailable()
+    SCD30_OPERATION_MEASUREMENT, //readMeasurement(), including the read delay and retries
+    SCD30_OPERATION_FRAME, //the bus part of reading the 18 byte frame
+    SCD30_OPERATION_COUNT //number of operations, not an operation
+};
+
+struct SCD30OperationStats
+{
+    uint32_t calls;
+    uint32_t failures;
+    uint32_t minTime; //us
+    uint32_t maxTime; //us
+    uint64_t totalTime; //us
+    uint32_t histogram[SCD30_HISTOGRAM_BUCKETS];
+};
+
+struct SCD30DriverStats
+{
+    SCD30OperationStats operations[SCD30_OPERATION_COUNT];
+
+    uint32_t readyChecks; //ready status reads
+    uint32_t notReady; //ready status reads without a new sample
+
+    uint64_t stretchTime; //us the frame reads took longer than the bytes need at the bus clock
+    uint32_t maxStretch; //us
+};
+
+const char* scd30OperationToString(SCD30Operation operation); //gets a short name of the operation
+
+void scd30RecordOperation(SCD30DriverStats &stats, SCD30Operation operation, uint32_t time, bool failed); //adds one timed operation
+void scd30RecordReady(SCD30DriverStats &stats, SCD30Error error); //counts a ready check, only answered checks are counted
+void scd30RecordStretch(SCD30DriverStats &stats, uint32_t time, uint32_t expected); //adds the clock stretching of one frame read
+void scd30PrintStats(Stream &stream, const SCD30DriverStats &stats); //prints a table of the stats
+
+//used inside the driver, they only record with stats attached and compile to nothing with SCD30_NO_INSTRUMENTATION
+#ifndef SCD30_NO_INSTRUMENTATION
+    #define SCD30_INSTRUMENT_START(name) uint32_t name = (driverStats != NULL) ? micros() : 0
+    #define SCD30_INSTRUMENT_END(operation, name, failed) \
+        do { if (driverStats != NULL) scd30RecordOperation(*driverStats, operation, micros() - (name), failed); } while (0)
+    #define SCD30_INSTRUMENT_FRAME(name, failed) \
+        do { if (driverStats != NULL) instrumentFrame(micros() - (name), failed); } while (0)
+    #define SCD30_INSTRUMENT_READY(error) \
+        do { if (driverStats != NULL) scd30RecordReady(*driverStats, error); } while (0)
+#else
+    #define SCD30_INSTRUMENT_START(name)
+    #define SCD30_INSTRUMENT_END(operation, name, failed)
+    #define SCD30_INSTRUMENT_FRAME(name, failed)
+    #define SCD30_INSTRUMENT_READY(error)
+#endif
+
+#endif
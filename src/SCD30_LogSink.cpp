@@ -0,0 +1,140 @@
+/*
+Append-only binary log of SCD30 samples in 512 byte blocks.
+See SCD30_LogSink.h for details.
+*/
+
+#include "SCD30_LogSink.h"
+#include "SCD30_Packed.h"
+#include "SCD30_CRC.h"
+
+static_assert(SCD30_PACKED_TICK_MS <= 0xFF, "the block header keeps SCD30_PACKED_TICK_MS in one byte");
+
+static void putUint16(uint8_t data[], uint16_t value)
+{
+    data[0] = value & 0xFF;
+    data[1] = value >> 8;
+}
+
+static void putUint32(uint8_t data[], uint32_t value)
+{
+    putUint16(&data[0], value & 0xFFFF);
+    putUint16(&data[2], value >> 16);
+}
+
+SCD30LogSink::SCD30LogSink(SCD30BlockWriter writer, uint32_t firstBlock) : writer(writer), blockNumber(firstBlock)
+{
+    //constructor
+}
+
+//packs the sample into the block, a full block is written right away
+//a failed write is tried again with the next sample, until then new samples are dropped
+boolean SCD30LogSink::add(const SCD30Measurement &sample)
+{
+    if (count == SCD30_LOG_SAMPLES_PER_BLOCK && writeBlock() == false)
+    {
+        dropped++;
+        return false;
+    }
+
+    if (count == 0)
+    {
+        putUint32(&block[12], sample.timestamp);
+        packedTime = sample.timestamp;
+    }
+
+    SCD30PackedSample packed = scd30Pack(sample, packedTime);
+    packedTime += (uint32_t)packed.delta * SCD30_PACKED_TICK_MS;
+
+    uint8_t *slot = &block[SCD30_LOG_HEADER_SIZE + count * SCD30_LOG_SAMPLE_SIZE];
+    putUint16(&slot[0], packed.co2);
+    putUint16(&slot[2], (uint16_t)packed.temperature);
+    putUint16(&slot[4], packed.humidity);
+    putUint16(&slot[6], packed.delta);
+    count++;
+
+    if (count == SCD30_LOG_SAMPLES_PER_BLOCK)
+        writeBlock();
+
+    return true;
+}
+
+//takes the samples out of the ring oldest first
+//stops when a full block can not be written, the remaining samples then stay in the ring
+uint16_t SCD30LogSink::drain(SCD30SampleRing &ring)
+{
+    uint16_t moved = 0;
+    const SCD30Measurement *sample;
+
+    while ((sample = ring.peek(0)) != NULL)
+    {
+        if (count == SCD30_LOG_SAMPLES_PER_BLOCK && writeBlock() == false)
+            break;
+
+        add(*sample);
+
+        SCD30Measurement removed;
+        ring.pop(removed);
+        moved++;
+    }
+
+    return moved;
+}
+
+//the samples after a flush start a new block, so every flush costs a whole block on the medium
+boolean SCD30LogSink::flush()
+{
+    if (count == 0)
+        return true;
+
+    return writeBlock();
+}
+
+boolean SCD30LogSink::writeBlock()
+{
+    memset(&block[SCD30_LOG_HEADER_SIZE + count * SCD30_LOG_SAMPLE_SIZE], 0, (SCD30_LOG_SAMPLES_PER_BLOCK - count) * SCD30_LOG_SAMPLE_SIZE);
+
+    putUint32(&block[0], SCD30_LOG_MAGIC);
+    block[4] = SCD30_LOG_VERSION;
+    block[5] = count;
+    block[6] = 0;
+    block[7] = SCD30_PACKED_TICK_MS;
+    putUint32(&block[8], blockNumber);
+
+    block[6] = scd30UpdateCRC8(SCD30_CRC8_INIT, block, SCD30_LOG_BLOCK_SIZE);
+
+    if (writer == NULL || writer(block, blockNumber) == false)
+    {
+        writeErrors++;
+        return false;
+    }
+
+    blockNumber++;
+    blocks++;
+    count = 0;
+    return true;
+}
+
+uint8_t SCD30LogSink::getPending()
+{
+    return count;
+}
+
+uint32_t SCD30LogSink::getNextBlock()
+{
+    return blockNumber;
+}
+
+uint32_t SCD30LogSink::getBlocks()
+{
+    return blocks;
+}
+
+uint32_t SCD30LogSink::getWriteErrors()
+{
+    return writeErrors;
+}
+
+uint32_t SCD30LogSink::getDropped()
+{
+    return dropped;
+}
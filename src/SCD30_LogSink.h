@@ -0,0 +1,67 @@
+/*
+Append-only binary log of SCD30 samples in 512 byte blocks, for SD cards and SPI flash.
+
+Samples are packed to the 8 byte SCD30PackedSample format and collected in a block in RAM.
+Only a full block is handed to the writer, in one call, so the medium sees one aligned 512 byte write
+per 62 samples instead of a short text write per sample.
+
+Block layout, all values little endian:
+    0   magic "SCD3"
+    4   version, SCD30_LOG_VERSION
+    5   number of samples in the block, at most SCD30_LOG_SAMPLES_PER_BLOCK
+    6   CRC-8 of the whole block, computed with this byte set to 0
+    7   SCD30_PACKED_TICK_MS of the samples
+    8   block number, counts up by one per block written
+    12  millis() of the first sample
+    16  samples: co2, temperature, humidity, delta, 2 bytes each, delta is the time since the previous sample
+Unused sample slots of a block written by flush() are 0.
+
+extras/scd30_log_decode.py turns a log file into CSV on the host.
+*/
+
+#ifndef SCD30_LogSink_h
+#define SCD30_LogSink_h
+
+#include "SCD30_I2C_lib.h"
+#include "SCD30_SampleBuffer.h"
+
+#define SCD30_LOG_BLOCK_SIZE 512
+#define SCD30_LOG_HEADER_SIZE 16
+#define SCD30_LOG_SAMPLE_SIZE 8 //bytes of one packed sample
+#define SCD30_LOG_SAMPLES_PER_BLOCK ((SCD30_LOG_BLOCK_SIZE - SCD30_LOG_HEADER_SIZE) / SCD30_LOG_SAMPLE_SIZE)
+#define SCD30_LOG_MAGIC 0x33444353UL //"SCD3" in the first 4 bytes
+#define SCD30_LOG_VERSION 1
+
+typedef boolean (*SCD30BlockWriter)(const uint8_t block[], uint32_t blockNumber); //writes one block of SCD30_LOG_BLOCK_SIZE bytes, returns false if it failed
+
+class SCD30LogSink
+{
+    public:
+        SCD30LogSink(SCD30BlockWriter writer, uint32_t firstBlock = 0); //constructor, firstBlock is the number of the first block written
+
+        boolean add(const SCD30Measurement &sample); //adds a sample, returns false if it was dropped because the full block could not be written
+        uint16_t drain(SCD30SampleRing &ring); //moves the samples of ring into blocks, returns number of samples moved
+        boolean flush(); //writes the block even if it is not full, e.g. before power down, returns false if the write failed
+
+        uint8_t getPending(); //gets number of samples not written yet
+        uint32_t getNextBlock(); //gets number of the next block written
+        uint32_t getBlocks(); //gets number of blocks written
+        uint32_t getWriteErrors(); //gets number of failed block writes
+        uint32_t getDropped(); //gets number of samples lost, because a full block could not be written
+
+    private:
+        boolean writeBlock(); //finishes the header and hands the block to the writer
+
+        SCD30BlockWriter writer;
+        uint32_t blockNumber;
+
+        uint8_t block[SCD30_LOG_BLOCK_SIZE];
+        uint8_t count = 0; //samples in block
+        uint32_t packedTime = 0; //millis() the deltas packed so far add up to, keeps the rounding from adding up
+
+        uint32_t blocks = 0;
+        uint32_t writeErrors = 0;
+        uint32_t dropped = 0;
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*
+In-memory transport that plays back recorded 18 byte measurement frames.
+See SCD30_MockTransport.h for details.
+*/
+
+#include "SCD30_MockTransport.h"
+#include "SCD30_I2C_lib.h"
+
+//registers the mock keeps, the settings and the firmware version
+const uint16_t SCD30MockTransport::registerCommands[SCD30_MOCK_REGISTERS] = {
+    SCD30_SET_MEASUREMENT_INTERVAL,
+    SCD30_SET_AUTOMATIC_SELFCALIBRATION,
+    SCD30_SET_FORCED_RECALIBRATION,
+    SCD30_SET_TEMPERATURE_OFFSET,
+    SCD30_SET_ALTITUDE_COMPENSATION,
+    SCD30_READ_FIRMWARE_VERSION
+};
+
+SCD30MockTransport::SCD30MockTransport(const uint8_t frames[][18], uint32_t frameCount) : frames(frames), frameCount(frameCount)
+{
+    //constructor, values of a sensor fresh out of the box
+    registers[0] = 2; //interval
+    registers[1] = 0; //ASC
+    registers[2] = 400; //FRC
+    registers[3] = 0; //temperature offset
+    registers[4] = 0; //altitude
+    registers[5] = 0x0342; //firmware 3.66
+}
+
+SCD30Error SCD30MockTransport::writeCommand(uint16_t command)
+{
+    this->command = command;
+    commands++;
+    return SCD30_OK;
+}
+
+//the argument is stored, so it can be read back
+SCD30Error SCD30MockTransport::writeCommand(uint16_t command, uint16_t argument)
+{
+    uint16_t *value = findRegister(command);
+    if (value != NULL)
+        *value = argument;
+
+    this->command = command;
+    commands++;
+    return SCD30_OK;
+}
+
+//returns the next frame after a read measurement command, otherwise the register of the last command
+SCD30Error SCD30MockTransport::read(uint8_t data[], uint8_t length)
+{
+    if (command == SCD30_READ_MEASUREMENT)
+    {
+        if (frameCount == 0 || length > 18)
+            return SCD30_ERROR_SHORT_READ;
+
+        memcpy(data, frames[nextFrame], length);
+
+        SCD30Error error = injectFault(data, length);
+        if (error != SCD30_OK)
+            return error; //the sensor still holds the frame
+
+        nextFrame++;
+        if (nextFrame >= frameCount)
+        {
+            nextFrame = 0;
+            nextFault = 0; //the faults happen again in the next pass
+        }
+
+        framesRead++;
+        return SCD30_OK;
+    }
+
+    uint16_t response;
+
+    if (command == SCD30_GET_READY_STATUS)
+        response = (frameCount > 0) ? 1 : 0;
+    else
+    {
+        uint16_t *value = findRegister(command);
+        if (value == NULL)
+            return SCD30_ERROR_NACK_DATA; //a real sensor would not answer either
+
+        response = *value;
+    }
+
+    if (length < 3)
+        return SCD30_ERROR_SHORT_READ;
+
+    data[0] = response >> 8;
+    data[1] = response & 0x00FF;
+    data[2] = scd30ComputeCRC8(data, 2);
+    return SCD30_OK;
+}
+
+void SCD30MockTransport::rewind()
+{
+    nextFrame = 0;
+    nextFault = 0;
+}
+
+void SCD30MockTransport::setRegister(uint16_t command, uint16_t value)
+{
+    uint16_t *stored = findRegister(command);
+    if (stored != NULL)
+        *stored = value;
+}
+
+void SCD30MockTransport::setFaults(const SCD30MockFault faults[], uint32_t faultCount)
+{
+    this->faults = faults;
+    this->faultCount = (faults != NULL) ? faultCount : 0;
+    nextFault = 0;
+}
+
+uint32_t SCD30MockTransport::getFaults(SCD30MockFaultType type)
+{
+    return faultsHappened[type];
+}
+
+uint32_t SCD30MockTransport::getFramesRead()
+{
+    return framesRead;
+}
+
+uint32_t SCD30MockTransport::getCommands()
+{
+    return commands;
+}
+
+//builds an 18 byte frame the way the sensor sends it: every float as two big endian words, each followed by its CRC
+void SCD30MockTransport::encodeFrame(uint8_t frame[], float co2, float temperature, float humidity)
+{
+    const float values[3] = { co2, temperature, humidity };
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+
+        uint8_t *word = &frame[i * 6];
+        word[0] = bits >> 24;
+        word[1] = bits >> 16;
+        word[2] = scd30ComputeCRC8(&word[0], 2);
+        word[3] = bits >> 8;
+        word[4] = bits;
+        word[5] = scd30ComputeCRC8(&word[3], 2);
+    }
+}
+
+uint16_t* SCD30MockTransport::findRegister(uint16_t command)
+{
+    for (uint8_t i = 0; i < SCD30_MOCK_REGISTERS; i++)
+    {
+        if (registerCommands[i] == command)
+            return &registers[i];
+    }
+
+    return NULL;
+}
+
+//applies every fault scheduled for the frame at nextFrame, each of them only once per pass
+//returns the error the read fails with, SCD30_OK if it goes through
+SCD30Error SCD30MockTransport::injectFault(uint8_t data[], uint8_t length)
+{
+    while (nextFault < faultCount && faults[nextFault].frame < nextFrame)
+        nextFault++; //fault on a frame that was skipped, e.g. after rewind()
+
+    while (nextFault < faultCount && faults[nextFault].frame == nextFrame)
+    {
+        const SCD30MockFault &fault = faults[nextFault++];
+        faultsHappened[fault.type]++;
+
+        switch (fault.type)
+        {
+            case SCD30_MOCK_FAULT_CRC:
+                data[length / 2] ^= 0x04; //a data or CRC byte, either way the CRC check fails
+                break;
+            case SCD30_MOCK_FAULT_NACK:
+                return SCD30_ERROR_NACK_ADDRESS;
+            case SCD30_MOCK_FAULT_STRETCH:
+                delayMicroseconds(fault.duration);
+                break;
+        }
+    }
+
+    return SCD30_OK;
+}
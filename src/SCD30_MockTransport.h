@@ -0,0 +1,77 @@
+/*
+In-memory transport that plays back recorded 18 byte measurement frames instead of talking to a sensor.
+
+Used to measure and check the driver without hardware: the ready status is always 1,
+every read measurement command returns the next frame (starting over after the last one),
+and settings written with a command are returned when they are read back.
+There is no read delay.
+
+setFaults() adds a schedule of faults to the playback, e.g. the errors seen on a real bus next to a recorded trace.
+A fault is tied to the index of a frame and happens once every time the playback reaches that frame.
+*/
+
+#ifndef SCD30_MockTransport_h
+#define SCD30_MockTransport_h
+
+#include "SCD30_Transport.h"
+
+#define SCD30_MOCK_REGISTERS 6 //number of registers the mock keeps
+
+enum SCD30MockFaultType
+{
+    SCD30_MOCK_FAULT_CRC, //one bit of the frame is flipped, the frame is used up
+    SCD30_MOCK_FAULT_NACK, //the read is not acknowledged, the frame is kept and returned by the next read
+    SCD30_MOCK_FAULT_STRETCH //the sensor holds SCL, the read takes duration us longer
+};
+
+//one fault of the schedule, the schedule has to be sorted by frame
+struct SCD30MockFault
+{
+    uint32_t frame; //index of the frame the fault happens on
+    SCD30MockFaultType type;
+    uint16_t duration; //us, only used by SCD30_MOCK_FAULT_STRETCH
+};
+
+class SCD30MockTransport : public SCD30Transport
+{
+    public:
+        SCD30MockTransport(const uint8_t frames[][18], uint32_t frameCount); //constructor, frames have to outlive the transport
+
+        SCD30Error writeCommand(uint16_t command);
+        SCD30Error writeCommand(uint16_t command, uint16_t argument);
+        SCD30Error read(uint8_t data[], uint8_t length);
+
+        uint32_t getReadDelay() { return 0; }
+
+        void rewind(); //starts playback from the first frame again
+        void setRegister(uint16_t command, uint16_t value); //sets the value returned when the register is read
+        void setFaults(const SCD30MockFault faults[], uint32_t faultCount); //sets the fault schedule, it has to outlive the transport, NULL removes it
+
+        uint32_t getFramesRead(); //gets number of frames played back
+        uint32_t getCommands(); //gets number of commands written
+        uint32_t getFaults(SCD30MockFaultType type); //gets number of faults of type that happened
+
+        static void encodeFrame(uint8_t frame[], float co2, float temperature, float humidity); //builds a frame with correct CRCs
+
+    private:
+        uint16_t* findRegister(uint16_t command); //gets the stored value of a register, NULL if the mock does not keep it
+        SCD30Error injectFault(uint8_t data[], uint8_t length); //applies the faults scheduled for the frame that is read
+
+        const uint8_t (*frames)[18];
+        uint32_t frameCount;
+        uint32_t nextFrame = 0;
+
+        uint16_t command = 0; //last command, decides what read() returns
+        uint32_t framesRead = 0;
+        uint32_t commands = 0;
+
+        const SCD30MockFault *faults = NULL;
+        uint32_t faultCount = 0;
+        uint32_t nextFault = 0; //first fault that has not happened in this pass of the playback
+        uint32_t faultsHappened[3] = {};
+
+        static const uint16_t registerCommands[SCD30_MOCK_REGISTERS];
+        uint16_t registers[SCD30_MOCK_REGISTERS];
+};
+
+#endif
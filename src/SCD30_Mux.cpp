@@ -0,0 +1,89 @@
+/*
+Minimal driver for a TCA9548A (or compatible) I2C multiplexer.
+See SCD30_Mux.h for details.
+*/
+
+#include "SCD30_Mux.h"
+
+SCD30Mux *SCD30Mux::first = NULL;
+
+SCD30Mux::SCD30Mux(TwoWire &wirePort, uint8_t address) : wire(&wirePort), address(address)
+{
+    //constructor
+    next = first;
+    first = this;
+}
+
+SCD30Mux::~SCD30Mux()
+{
+    //destructor
+    for (SCD30Mux **mux = &first; *mux != NULL; mux = &(*mux)->next)
+    {
+        if (*mux == this)
+        {
+            *mux = next;
+            break;
+        }
+    }
+}
+
+//connects the channel to the bus, any other multiplexer on the same bus is turned off first
+//returns true if the channel is selected
+boolean SCD30Mux::select(uint8_t channel)
+{
+    if (channel >= SCD30_MUX_CHANNELS)
+        return false;
+
+    if (this->channel == channel)
+        return true; //already selected, no need to talk to the multiplexer
+
+    for (SCD30Mux *mux = first; mux != NULL; mux = mux->next)
+    {
+        if (mux != this && mux->wire == wire && mux->channel != SCD30_MUX_NO_CHANNEL)
+            mux->disable();
+    }
+
+    if (writeControl(1 << channel) == false)
+    {
+        this->channel = SCD30_MUX_NO_CHANNEL; //we do not know what is selected now
+        return false;
+    }
+
+    this->channel = channel;
+    return true;
+}
+
+//disconnects all channels
+boolean SCD30Mux::disable()
+{
+    channel = SCD30_MUX_NO_CHANNEL;
+    return writeControl(0);
+}
+
+//forgets the selected channel, the next select() always writes to the multiplexer
+void SCD30Mux::invalidate()
+{
+    channel = SCD30_MUX_NO_CHANNEL;
+}
+
+uint8_t SCD30Mux::getChannel()
+{
+    return channel;
+}
+
+TwoWire& SCD30Mux::getWire()
+{
+    return *wire;
+}
+
+//every bit of the control register connects one channel
+boolean SCD30Mux::writeControl(uint8_t control)
+{
+    wire->beginTransmission(address);
+    wire->write(control);
+
+    if (wire->endTransmission() != 0)
+        return false; //multiplexer did not ACK
+
+    return true;
+}
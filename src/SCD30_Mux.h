@@ -0,0 +1,50 @@
+/*
+Minimal driver for a TCA9548A (or compatible) I2C multiplexer.
+
+The SCD30 has a fixed I2C address, so more than one sensor per bus needs a multiplexer.
+The selected channel is remembered, select() only talks to the multiplexer when the channel changes.
+All multiplexers are kept in a list, so selecting a channel on one multiplexer first turns off
+any other multiplexer on the same bus, otherwise two sensors with the same address would be connected at once.
+*/
+
+#ifndef SCD30_Mux_h
+#define SCD30_Mux_h
+
+#if (ARDUINO >= 100)
+    #include "Arduino.h"
+#else
+    #include "WProgram.h"
+#endif
+
+#include <Wire.h>
+
+#define SCD30_MUX_DEFAULT_ADDRESS 0x70 //TCA9548A with A0, A1 and A2 low
+#define SCD30_MUX_CHANNELS 8
+#define SCD30_MUX_NO_CHANNEL 0xFF //no channel selected
+
+class SCD30Mux
+{
+    public:
+        SCD30Mux(TwoWire &wirePort = Wire, uint8_t address = SCD30_MUX_DEFAULT_ADDRESS); //constructor
+        ~SCD30Mux(); //destructor
+
+        boolean select(uint8_t channel); //connects the channel to the bus, does nothing if it is already selected
+        boolean disable(); //disconnects all channels
+        void invalidate(); //forgets the selected channel, e.g. after the multiplexer was reset
+
+        uint8_t getChannel(); //gets selected channel, SCD30_MUX_NO_CHANNEL if none
+        TwoWire& getWire(); //gets the bus the multiplexer is on
+
+    private:
+        boolean writeControl(uint8_t control); //writes the control register
+
+        TwoWire *wire;
+        uint8_t address;
+        uint8_t channel = SCD30_MUX_NO_CHANNEL;
+
+        //list of all multiplexers, used to turn off the others on the same bus
+        static SCD30Mux *first;
+        SCD30Mux *next = NULL;
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+Compact 8 byte sample format for storage and radio payloads.
+See SCD30_Packed.h for details.
+*/
+
+#include "SCD30_Packed.h"
+#include "SCD30_I2C_lib.h"
+
+//limits an integer to the range of the packed field
+static int32_t clamp(int32_t value, int32_t minimum, int32_t maximum)
+{
+    if (value < minimum) return minimum;
+    if (value > maximum) return maximum;
+    return value;
+}
+
+//converts a float, given as its IEEE-754 bit pattern, multiplied by scale to the nearest integer
+//only integer operations are used: the value is mantissa * 2^(exponent - 150)
+//scale has to be at most 128, so that mantissa * scale fits into 31 bits
+//zero, denormals and NaN give 0, values out of range saturate
+int32_t scd30FloatBitsToFixed(uint32_t bits, uint8_t scale)
+{
+    uint8_t exponent = (bits >> 23) & 0xFF;
+    boolean negative = (bits & 0x80000000UL) != 0;
+
+    if (exponent == 0 || scale == 0)
+        return 0; //zero or denormal, far below what the sensor can resolve
+
+    if (exponent == 0xFF)
+    {
+        if ((bits & 0x007FFFFFUL) != 0)
+            return 0; //NaN
+
+        return negative ? INT32_MIN : INT32_MAX; //infinity
+    }
+
+    uint32_t product = ((bits & 0x007FFFFFUL) | 0x00800000UL) * (uint32_t)scale; //mantissa with the implicit 1, below 2^31
+    int16_t shift = 150 - exponent;
+    uint32_t result;
+
+    if (shift > 31)
+        result = 0; //below 0.5 after rounding
+    else if (shift > 0)
+        result = (product + ((uint32_t)1 << (shift - 1))) >> shift; //round half up
+    else if (shift == 0)
+        result = product;
+    else if (-shift >= 31 || product > (0x7FFFFFFFUL >> -shift))
+        result = 0x7FFFFFFFUL; //would not fit
+    else
+        result = product << -shift;
+
+    return negative ? -(int32_t)result : (int32_t)result;
+}
+
+//packs raw IEEE-754 words as they are sent by the sensor, elapsed is the time since the reference in ms
+//integer operations only
+SCD30PackedSample scd30PackRaw(uint32_t co2Bits, uint32_t temperatureBits, uint32_t humidityBits, uint32_t elapsed)
+{
+    SCD30PackedSample packed;
+    uint32_t ticks = elapsed / SCD30_PACKED_TICK_MS;
+
+    packed.co2 = clamp(scd30FloatBitsToFixed(co2Bits, 1), 0, UINT16_MAX);
+    packed.temperature = clamp(scd30FloatBitsToFixed(temperatureBits, 100), INT16_MIN, INT16_MAX);
+    packed.humidity = clamp(scd30FloatBitsToFixed(humidityBits, 100), 0, UINT16_MAX);
+    packed.delta = (ticks > UINT16_MAX) ? UINT16_MAX : ticks;
+
+    return packed;
+}
+
+//packs a sample, the timestamp is stored relative to referenceTime
+//the floats are only reinterpreted as their bit patterns, so this also avoids float math
+SCD30PackedSample scd30Pack(const SCD30Measurement &sample, uint32_t referenceTime)
+{
+    uint32_t co2Bits;
+    uint32_t temperatureBits;
+    uint32_t humidityBits;
+
+    memcpy(&co2Bits, &sample.co2, sizeof(co2Bits));
+    memcpy(&temperatureBits, &sample.temperature, sizeof(temperatureBits));
+    memcpy(&humidityBits, &sample.humidity, sizeof(humidityBits));
+
+    return scd30PackRaw(co2Bits, temperatureBits, humidityBits, sample.timestamp - referenceTime);
+}
+
+//unpacks a sample, referenceTime has to be the same that was used for packing
+//the sequence number is not part of the packed format and is set to 0
+void scd30Unpack(const SCD30PackedSample &packed, uint32_t referenceTime, SCD30Measurement &sample)
+{
+    sample.co2 = packed.co2;
+    sample.temperature = packed.temperature / 100.0f;
+    sample.humidity = packed.humidity / 100.0f;
+    sample.timestamp = referenceTime + (uint32_t)packed.delta * SCD30_PACKED_TICK_MS;
+    sample.sequence = 0;
+}
@@ -0,0 +1,39 @@
+/*
+Compact 8 byte sample format for storage and radio payloads.
+
+A packed sample holds CO2 in ppm, temperature in 0.01 °C, humidity in 0.01 %RH
+and the time since a reference point (e.g. the previous sample or the start of a block)
+in ticks of SCD30_PACKED_TICK_MS.
+
+Packing only uses integer operations, the values are taken straight from the IEEE-754 bit patterns
+the sensor sends, so no float math is pulled in. Unpacking back to a SCD30Measurement uses floats.
+*/
+
+#ifndef SCD30_Packed_h
+#define SCD30_Packed_h
+
+#include <stdint.h>
+
+#ifndef SCD30_PACKED_TICK_MS
+    #define SCD30_PACKED_TICK_MS 100 //resolution of the packed timestamp, default range is 0 to 6553.5 s
+#endif
+
+struct SCD30Measurement;
+
+struct SCD30PackedSample
+{
+    uint16_t co2; //CO2 concentration in ppm
+    int16_t temperature; //temperature in 0.01 °C
+    uint16_t humidity; //relative humidity in 0.01 %RH
+    uint16_t delta; //time since the reference in SCD30_PACKED_TICK_MS, saturates at 0xFFFF
+};
+
+static_assert(sizeof(SCD30PackedSample) == 8, "SCD30PackedSample has to be 8 bytes");
+
+int32_t scd30FloatBitsToFixed(uint32_t bits, uint8_t scale); //rounds the float with IEEE-754 bit pattern bits, multiplied by scale (at most 128), to an integer
+
+SCD30PackedSample scd30PackRaw(uint32_t co2Bits, uint32_t temperatureBits, uint32_t humidityBits, uint32_t elapsed); //packs raw IEEE-754 words, elapsed in ms
+SCD30PackedSample scd30Pack(const SCD30Measurement &sample, uint32_t referenceTime); //packs a sample, referenceTime is a millis() value
+void scd30Unpack(const SCD30PackedSample &packed, uint32_t referenceTime, SCD30Measurement &sample); //unpacks a sample, sequence is set to 0
+
+#endif
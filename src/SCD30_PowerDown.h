@@ -0,0 +1,162 @@
+/*
+Optional power-down sleep for AVR, the default scd30Sleep() only idles.
+
+Include this header in exactly one file of the sketch, it defines the sleep function and the interrupt vectors it needs:
+    #include "SCD30_PowerDown.h"
+    scdSensor.setSleepHook(scd30SleepPowerDown);
+
+The watchdog ends a timed sleep and a pin change interrupt on RDY wakes the core (INT0/INT1 edges can not, a pin change can).
+Timer 0 stops in power-down, so the watchdog time is added to millis(). Waiting for RDY the watchdog wakes the core
+every 16 ms, the time of the RDY wake up itself is not counted, so millis() falls behind by up to 16 ms per sample,
+and the watchdog clock is only accurate to about 10 %.
+WDTCSR is saved before and written back after each sleep, so a reset watchdog of the sketch keeps running,
+call wdt_reset() as usual, it is paused while the MCU sleeps.
+
+This header defines WDT_vect and the PCINT vectors. If another library (e.g. SoftwareSerial) defines the PCINT vectors too,
+define SCD30_POWER_DOWN_NO_PCINT before the include, RDY is then only checked every 16 ms.
+Parts without WDTCSR (ATtiny, megaAVR 0-series) and other cores use scd30Sleep() instead.
+*/
+
+#ifndef SCD30_PowerDown_h
+#define SCD30_PowerDown_h
+
+#if (ARDUINO >= 100)
+    #include "Arduino.h"
+#else
+    #include "WProgram.h"
+#endif
+
+#include "SCD30_Sleep.h"
+
+#if defined(__AVR__) && defined(WDTCSR) && defined(WDIE)
+
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include <avr/interrupt.h>
+
+//timer 0 stops in power-down, the time slept is added to the counter behind millis() of the Arduino AVR core
+extern volatile unsigned long timer0_millis;
+
+static volatile boolean scd30WatchdogFired = false;
+
+ISR(WDT_vect)
+{
+    scd30WatchdogFired = true;
+}
+
+//only wake the core from power-down, the RDY pin is checked by the caller
+#if !defined(SCD30_POWER_DOWN_NO_PCINT)
+    #if defined(PCINT0_vect)
+        EMPTY_INTERRUPT(PCINT0_vect);
+    #endif
+    #if defined(PCINT1_vect)
+        EMPTY_INTERRUPT(PCINT1_vect);
+    #endif
+    #if defined(PCINT2_vect)
+        EMPTY_INTERRUPT(PCINT2_vect);
+    #endif
+    #if defined(PCINT3_vect)
+        EMPTY_INTERRUPT(PCINT3_vect);
+    #endif
+#endif
+
+//ms of the watchdog periods, index is the prescaler
+static const uint16_t scd30WatchdogPeriods[] = { 16, 32, 64, 125, 250, 500, 1000, 2000, 4000, 8000 };
+
+//writes WDTCSR with the timed sequence, interrupts have to be off
+static void scd30WriteWatchdog(uint8_t value)
+{
+    wdt_reset();
+    MCUSR &= ~_BV(WDRF); //WDE can not be cleared while WDRF is set
+    WDTCSR = _BV(WDCE) | _BV(WDE); //timed sequence, the next write has to follow within 4 cycles
+    WDTCSR = value;
+}
+
+//power-down, woken by the watchdog, and by a pin change interrupt on RDY
+//waiting for RDY the watchdog period is the shortest one, the time of a wake up by RDY is not known
+//and is not added to millis(), so the clock stays within one period of it
+void scd30SleepPowerDown(SCD30WakeSource source, uint8_t pin, uint32_t timeout)
+{
+    if (timeout < scd30WatchdogPeriods[0])
+    {
+        scd30Sleep(source, pin, timeout); //idle
+        return;
+    }
+
+    uint8_t prescaler = 0;
+    if (source == SCD30_WAKE_TIMER)
+    {
+        while (prescaler < 9 && scd30WatchdogPeriods[prescaler + 1] <= timeout)
+            prescaler++;
+    }
+
+    volatile uint8_t *pcicr = NULL;
+    volatile uint8_t *pcmsk = NULL;
+    uint8_t pcicrBit = 0;
+    uint8_t pcmskBit = 0;
+    uint8_t oldPcicr = 0;
+    uint8_t oldPcmsk = 0;
+
+#if defined(digitalPinToPCICR) && !defined(SCD30_POWER_DOWN_NO_PCINT)
+    if (source == SCD30_WAKE_READY && digitalPinToPCICR(pin) != NULL)
+    {
+        pcicr = digitalPinToPCICR(pin);
+        pcicrBit = digitalPinToPCICRbit(pin);
+        pcmsk = digitalPinToPCMSK(pin);
+        pcmskBit = digitalPinToPCMSKbit(pin);
+    }
+#endif
+
+    noInterrupts();
+    if (source == SCD30_WAKE_READY && digitalRead(pin) == HIGH)
+    {
+        interrupts(); //RDY already went high, do not sleep
+        return;
+    }
+
+    if (pcicr != NULL)
+    {
+        oldPcicr = *pcicr;
+        oldPcmsk = *pcmsk;
+        *pcmsk |= _BV(pcmskBit);
+        PCIFR = _BV(pcicrBit); //an old change would wake the core right away
+        *pcicr |= _BV(pcicrBit);
+    }
+
+    uint8_t oldWdtcsr = WDTCSR & ~(_BV(WDIF) | _BV(WDCE)); //1 in WDIF would clear the flag of the sketch
+    uint8_t bits = (prescaler & 0x07) | ((prescaler & 0x08) ? _BV(WDP3) : 0);
+
+    scd30WatchdogFired = false;
+    scd30WriteWatchdog(_BV(WDIE) | bits); //interrupt mode, it does not reset the MCU
+
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    interrupts(); //the instruction after sei is always executed, so no interrupt can be lost before sleep_cpu()
+    sleep_cpu();
+    sleep_disable();
+
+    noInterrupts();
+    scd30WriteWatchdog(oldWdtcsr); //the watchdog of the sketch, or off
+
+    if (pcicr != NULL)
+    {
+        *pcmsk = oldPcmsk;
+        *pcicr = oldPcicr;
+    }
+
+    if (scd30WatchdogFired == true)
+        timer0_millis = timer0_millis + scd30WatchdogPeriods[prescaler];
+    interrupts();
+}
+
+#else
+
+//no power-down known for this core, see scd30Sleep()
+void scd30SleepPowerDown(SCD30WakeSource source, uint8_t pin, uint32_t timeout)
+{
+    scd30Sleep(source, pin, timeout);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+/*
+FreeRTOS integration of the SCD30.
+See SCD30_RTOS.h for details.
+*/
+
+#include "SCD30_RTOS.h"
+
+#ifdef SCD30_FREERTOS
+
+//the sequence goes odd, the sample is copied, the sequence goes even again
+//the scheduler is suspended meanwhile, so a reader on the same core can not spin on a half written sample
+void SCD30Seqlock::write(const SCD30Measurement &sample)
+{
+    uint32_t current = __atomic_load_n(&sequence, __ATOMIC_RELAXED);
+
+    vTaskSuspendAll();
+
+    __atomic_store_n(&sequence, current + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE); //the odd sequence is seen before any byte of the sample
+
+    value = sample;
+
+    __atomic_store_n(&sequence, current + 2, __ATOMIC_RELEASE);
+
+    xTaskResumeAll();
+}
+
+//copies the sample until the sequence was even and the same before and after the copy
+boolean SCD30Seqlock::read(SCD30Measurement &sample)
+{
+    for (;;)
+    {
+        uint32_t before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+
+        if ((before & 1) != 0)
+            continue; //a write is in progress on the other core, it only takes a copy of the sample
+
+        sample = value;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE); //the copy is done before the sequence is read again
+
+        if (__atomic_load_n(&sequence, __ATOMIC_RELAXED) == before)
+            return (before != 0);
+    }
+}
+
+uint32_t SCD30Seqlock::getSequence()
+{
+    return __atomic_load_n(&sequence, __ATOMIC_ACQUIRE) / 2;
+}
+
+SCD30SensorTask::SCD30SensorTask(SCD30 &sensor, SemaphoreHandle_t busMutex) : scheduler(sensor), busMutex(busMutex)
+{
+    //constructor
+}
+
+//starts the task, from now on only the task may use the sensor
+//core pins the task on ESP32, it is ignored on other ports
+//returns false if the task is running already or could not be created
+boolean SCD30SensorTask::start(uint32_t stackSize, UBaseType_t priority, BaseType_t core)
+{
+    if (handle != NULL)
+        return false;
+
+    stopRequested = false;
+    scheduler.begin(); //the interval is known by now
+
+#if defined(ARDUINO_ARCH_ESP32)
+    if (core != SCD30_TASK_NO_CORE)
+        return (xTaskCreatePinnedToCore(taskEntry, "SCD30", stackSize, this, priority, &handle, core) == pdPASS);
+#else
+    (void)core; //only ESP32 can pin a task
+#endif
+
+    return (xTaskCreate(taskEntry, "SCD30", stackSize, this, priority, &handle) == pdPASS);
+}
+
+//the task ends by itself, so it never ends while it holds the bus mutex
+void SCD30SensorTask::stop()
+{
+    stopRequested = true;
+}
+
+boolean SCD30SensorTask::isRunning()
+{
+    return (handle != NULL);
+}
+
+boolean SCD30SensorTask::getLatest(SCD30Measurement &sample)
+{
+    return latest.read(sample);
+}
+
+uint32_t SCD30SensorTask::getSequence()
+{
+    return latest.getSequence();
+}
+
+uint32_t SCD30SensorTask::getBusWaits()
+{
+    return __atomic_load_n(&busWaits, __ATOMIC_RELAXED);
+}
+
+SCD30Scheduler& SCD30SensorTask::getScheduler()
+{
+    return scheduler;
+}
+
+void SCD30SensorTask::taskEntry(void *parameter)
+{
+    static_cast<SCD30SensorTask*>(parameter)->run();
+}
+
+//sleeps until the scheduler wants to check the sensor, takes the bus only for the check and the read
+void SCD30SensorTask::run()
+{
+    while (stopRequested == false)
+    {
+        uint32_t wait = scheduler.timeUntilNextPoll();
+
+        if (wait > 0)
+        {
+            TickType_t ticks = pdMS_TO_TICKS(wait);
+            vTaskDelay((ticks > 0) ? ticks : 1);
+            continue;
+        }
+
+        if (busMutex != NULL && xSemaphoreTake(busMutex, pdMS_TO_TICKS(SCD30_TASK_BUS_WAIT)) != pdTRUE)
+        {
+            __atomic_fetch_add(&busWaits, 1, __ATOMIC_RELAXED); //++ on a volatile is not atomic, and deprecated in C++20
+            continue;
+        }
+
+        SCD30Measurement sample;
+        boolean updated = scheduler.update(sample);
+
+        if (busMutex != NULL)
+            xSemaphoreGive(busMutex);
+
+        if (updated == true)
+            latest.write(sample);
+    }
+
+    handle = NULL;
+    vTaskDelete(NULL);
+}
+
+#endif
@@ -0,0 +1,84 @@
+/*
+FreeRTOS integration of the SCD30.
+
+SCD30SensorTask runs a task that owns the sensor: it reads the samples, paced by an SCD30Scheduler,
+and publishes every new sample through an SCD30Seqlock. Tasks on any core get the latest sample
+with getLatest(), that never waits for the bus and never takes a lock.
+If other drivers use the same bus, pass the mutex they take, the task holds it only while it is on the bus.
+
+Built on ESP32, on other FreeRTOS ports (e.g. RP2040 with FreeRTOS) define SCD30_FREERTOS.
+*/
+
+#ifndef SCD30_RTOS_h
+#define SCD30_RTOS_h
+
+#if defined(ARDUINO_ARCH_ESP32) && !defined(SCD30_FREERTOS)
+    #define SCD30_FREERTOS
+#endif
+
+#ifdef SCD30_FREERTOS
+
+#include "SCD30_I2C_lib.h"
+#include "SCD30_Scheduler.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+    #include "freertos/FreeRTOS.h"
+    #include "freertos/task.h"
+    #include "freertos/semphr.h"
+#else
+    #include <FreeRTOS.h>
+    #include <task.h>
+    #include <semphr.h>
+#endif
+
+#define SCD30_TASK_STACK 4096 //bytes on ESP32, words on other ports
+#define SCD30_TASK_PRIORITY 1
+#define SCD30_TASK_NO_CORE -1 //let the scheduler pick the core
+#define SCD30_TASK_BUS_WAIT 1000 //ms the task waits for the bus mutex before it counts a bus wait and tries again later
+
+//single writer, any number of readers, readers never block the writer
+//the sequence is odd while a write is in progress, a reader retries if it changed during its copy
+class SCD30Seqlock
+{
+    public:
+        void write(const SCD30Measurement &sample); //only one task may write
+        boolean read(SCD30Measurement &sample); //gets a consistent copy, false if nothing was written yet
+        uint32_t getSequence(); //gets a number that changes with every write
+
+    private:
+        uint32_t sequence = 0;
+        SCD30Measurement value = {};
+};
+
+class SCD30SensorTask
+{
+    public:
+        SCD30SensorTask(SCD30 &sensor, SemaphoreHandle_t busMutex = NULL); //constructor, busMutex is shared with other drivers on the bus
+
+        boolean start(uint32_t stackSize = SCD30_TASK_STACK, UBaseType_t priority = SCD30_TASK_PRIORITY, BaseType_t core = SCD30_TASK_NO_CORE); //starts the task, begin() the sensor before
+        void stop(); //asks the task to end, it does so before its next bus access
+        boolean isRunning();
+
+        boolean getLatest(SCD30Measurement &sample); //gets the latest sample, never blocks, false if there is none yet
+        uint32_t getSequence(); //changes with every new sample, cheap way to see if there is something new
+
+        uint32_t getBusWaits(); //gets number of times the bus mutex was not free within SCD30_TASK_BUS_WAIT
+
+        SCD30Scheduler& getScheduler();
+
+    private:
+        static void taskEntry(void *parameter);
+        void run();
+
+        SCD30Scheduler scheduler;
+        SemaphoreHandle_t busMutex;
+        SCD30Seqlock latest;
+
+        TaskHandle_t handle = NULL;
+        volatile boolean stopRequested = false;
+        uint32_t busWaits = 0; //written by the task, read by any task, only through __atomic builtins
+};
+
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+/*
+Fixed capacity ring buffer of SCD30 samples, no heap allocation.
+See SCD30_SampleBuffer.h for details.
+*/
+
+#include "SCD30_SampleBuffer.h"
+
+SCD30SampleRing::SCD30SampleRing(SCD30Measurement *storage, uint16_t capacity) : storage(storage), length(capacity)
+{
+    //constructor
+}
+
+//adds a sample at the end of the buffer
+//if the buffer is full the oldest sample is overwritten, returns false in that case
+boolean SCD30SampleRing::push(const SCD30Measurement &sample)
+{
+    uint16_t tail = head + count;
+    if (tail >= length)
+        tail -= length;
+
+    storage[tail] = sample;
+
+    if (count < length)
+    {
+        count++;
+        return true;
+    }
+
+    //buffer was full, the oldest sample is gone
+    head = tail + 1;
+    if (head >= length)
+        head = 0;
+
+    overflows++;
+    return false;
+}
+
+//removes the oldest sample
+boolean SCD30SampleRing::pop(SCD30Measurement &sample)
+{
+    if (count == 0)
+        return false;
+
+    sample = storage[head];
+
+    head++;
+    if (head >= length)
+        head = 0;
+
+    count--;
+    return true;
+}
+
+//gets the sample at index without removing it, 0 is the oldest sample
+const SCD30Measurement* SCD30SampleRing::peek(uint16_t index)
+{
+    if (index >= count)
+        return NULL;
+
+    uint16_t position = head + index;
+    if (position >= length)
+        position -= length;
+
+    return &storage[position];
+}
+
+//hands out up to maxCount oldest samples and removes them from the buffer
+//the samples are passed straight from the buffer memory, so the callback is called at most twice:
+//once up to the end of the memory and once more from its start if the samples wrap around
+//returns number of samples handed out
+uint16_t SCD30SampleRing::drain(SCD30DrainCallback callback, uint16_t maxCount)
+{
+    uint16_t total = (maxCount < count) ? maxCount : count;
+    uint16_t remaining = total;
+
+    while (remaining > 0)
+    {
+        uint16_t span = length - head; //samples until the end of the memory
+        if (span > remaining)
+            span = remaining;
+
+        callback(&storage[head], span);
+
+        head += span;
+        if (head >= length)
+            head = 0;
+
+        count -= span;
+        remaining -= span;
+    }
+
+    return total;
+}
+
+void SCD30SampleRing::clear()
+{
+    head = 0;
+    count = 0;
+}
+
+uint16_t SCD30SampleRing::size()
+{
+    return count;
+}
+
+uint16_t SCD30SampleRing::capacity()
+{
+    return length;
+}
+
+boolean SCD30SampleRing::empty()
+{
+    return (count == 0);
+}
+
+boolean SCD30SampleRing::full()
+{
+    return (count == length);
+}
+
+uint32_t SCD30SampleRing::getOverflows()
+{
+    return overflows;
+}
@@ -0,0 +1,60 @@
+/*
+Fixed capacity ring buffer of SCD30 samples, no heap allocation.
+
+Declare a SCD30SampleBuffer<N> and attach it with SCD30::attachBuffer(), every sample read by the
+sensor is then pushed into it. When the buffer is full the oldest sample is overwritten and counted
+as an overflow.
+
+drain() hands the samples out in at most two contiguous spans, so a whole batch can be sent
+or written in one go instead of one sample at a time.
+*/
+
+#ifndef SCD30_SampleBuffer_h
+#define SCD30_SampleBuffer_h
+
+#include "SCD30_I2C_lib.h"
+
+typedef void (*SCD30DrainCallback)(const SCD30Measurement samples[], uint16_t count); //gets a contiguous span of samples, oldest first
+
+//the part of the buffer that does not depend on the capacity, this is what SCD30 pushes into
+class SCD30SampleRing
+{
+    public:
+        boolean push(const SCD30Measurement &sample); //adds a sample, returns false if the oldest sample had to be overwritten
+        boolean pop(SCD30Measurement &sample); //removes the oldest sample, returns false if the buffer is empty
+        const SCD30Measurement* peek(uint16_t index); //gets the sample at index, 0 being the oldest, NULL if there is none
+
+        uint16_t drain(SCD30DrainCallback callback, uint16_t maxCount = 0xFFFF); //hands out and removes up to maxCount oldest samples
+        void clear(); //removes all samples
+
+        uint16_t size(); //gets number of samples in the buffer
+        uint16_t capacity(); //gets maximum number of samples
+        boolean empty();
+        boolean full();
+
+        uint32_t getOverflows(); //gets number of samples overwritten because the buffer was full
+
+    protected:
+        SCD30SampleRing(SCD30Measurement *storage, uint16_t capacity); //constructor, only used by SCD30SampleBuffer
+
+    private:
+        SCD30Measurement *storage;
+        uint16_t length; //capacity
+        uint16_t head = 0; //index of the oldest sample
+        uint16_t count = 0;
+        uint32_t overflows = 0;
+};
+
+template <uint16_t N>
+class SCD30SampleBuffer : public SCD30SampleRing
+{
+    static_assert(N > 0, "SCD30SampleBuffer needs room for at least one sample");
+
+    public:
+        SCD30SampleBuffer() : SCD30SampleRing(samples, N) {}
+
+    private:
+        SCD30Measurement samples[N];
+};
+
+#endif
@@ -0,0 +1,97 @@
+/*
+Adaptive polling for the SCD30.
+See SCD30_Scheduler.h for details.
+*/
+
+#include "SCD30_Scheduler.h"
+
+SCD30Scheduler::SCD30Scheduler(SCD30 &sensor) : sensor(&sensor)
+{
+    //constructor
+}
+
+//seeds the period from the measurement interval, that is answered from the settings cache if it is known
+//until the first sample is read the sensor is checked every SCD30_SCHEDULER_POLL_SPACING ms
+void SCD30Scheduler::begin()
+{
+    uint16_t interval = sensor->getMeasurementInterval();
+
+    if (interval >= 2)
+        period = (uint32_t)interval * 1000;
+
+    synced = false;
+    polled = false;
+}
+
+//checks the sensor if a sample is due
+//returns true and fills measurement when a new sample was read, otherwise does nothing on the bus most of the time
+boolean SCD30Scheduler::update(SCD30Measurement &measurement)
+{
+    if (timeUntilNextPoll() > 0)
+        return false;
+
+    lastPoll = millis();
+    polled = true;
+    polls++;
+
+    if (sensor->read(measurement) == false)
+        return false;
+
+    //learn the period from samples that follow each other, a missed sample would count twice
+    if (synced == true)
+    {
+        uint32_t observed = measurement.timestamp - lastSample;
+
+        if (observed > period / 2 && observed < period + period / 2)
+        {
+            int32_t difference = (int32_t)(observed - period);
+            period += difference / (1 << SCD30_SCHEDULER_SMOOTHING);
+        }
+    }
+
+    lastSample = measurement.timestamp;
+    nextExpected = measurement.timestamp + period;
+    synced = true;
+    samples++;
+
+    return true;
+}
+
+//returns ms until update() will check the sensor again
+//before the first sample, and once the expected sample is due, that is the poll spacing
+uint32_t SCD30Scheduler::timeUntilNextPoll()
+{
+    uint32_t now = millis();
+    uint32_t wait = 0;
+
+    if (synced == true)
+    {
+        int32_t untilWindow = (int32_t)(nextExpected - SCD30_SCHEDULER_LEAD - now);
+        if (untilWindow > 0)
+            wait = untilWindow;
+    }
+
+    if (polled == true)
+    {
+        uint32_t sinceLastPoll = now - lastPoll;
+        if (sinceLastPoll < SCD30_SCHEDULER_POLL_SPACING && SCD30_SCHEDULER_POLL_SPACING - sinceLastPoll > wait)
+            wait = SCD30_SCHEDULER_POLL_SPACING - sinceLastPoll;
+    }
+
+    return wait;
+}
+
+uint32_t SCD30Scheduler::getPeriod()
+{
+    return period;
+}
+
+uint32_t SCD30Scheduler::getPolls()
+{
+    return polls;
+}
+
+uint32_t SCD30Scheduler::getSamples()
+{
+    return samples;
+}
@@ -0,0 +1,47 @@
+/*
+Adaptive polling for the SCD30.
+
+Instead of checking the ready status all the time, the scheduler learns the period between samples
+(seeded from the measurement interval) and stays off the bus until shortly before the next sample is due.
+Only then it checks the ready status, every SCD30_SCHEDULER_POLL_SPACING ms, until the sample is read.
+timeUntilNextPoll() tells how long the MCU can sleep.
+*/
+
+#ifndef SCD30_Scheduler_h
+#define SCD30_Scheduler_h
+
+#include "SCD30_I2C_lib.h"
+
+#define SCD30_SCHEDULER_LEAD 200 //ms before the expected sample the ready checks start
+#define SCD30_SCHEDULER_POLL_SPACING 100 //ms between ready checks
+#define SCD30_SCHEDULER_SMOOTHING 3 //the learned period moves 1/2^3 of the way to every new observation
+
+class SCD30Scheduler
+{
+    public:
+        SCD30Scheduler(SCD30 &sensor); //constructor
+
+        void begin(); //seeds the period from the measurement interval and starts polling right away
+
+        boolean update(SCD30Measurement &measurement); //checks the sensor if a sample is due, returns true with a new sample
+
+        uint32_t timeUntilNextPoll(); //gets ms until update() will touch the bus again, the MCU can sleep that long
+        uint32_t getPeriod(); //gets the learned period between samples in ms
+        uint32_t getPolls(); //gets number of ready checks done
+        uint32_t getSamples(); //gets number of samples read
+
+    private:
+        SCD30 *sensor;
+
+        uint32_t period = 2000; //ms between samples
+        uint32_t nextExpected = 0; //millis() when the next sample is expected
+        uint32_t lastPoll = 0; //millis() of the last ready check
+        uint32_t lastSample = 0; //timestamp of the last sample
+        boolean synced = false; //true once a sample was read and nextExpected is known
+        boolean polled = false; //true once a ready check was done
+
+        uint32_t polls = 0;
+        uint32_t samples = 0;
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*
+Low power helpers for the SCD30.
+See SCD30_Sleep.h for details.
+*/
+
+#if (ARDUINO >= 100)
+    #include "Arduino.h"
+#else
+    #include "WProgram.h"
+#endif
+
+#include "SCD30_Sleep.h"
+
+#if defined(__AVR__)
+    #include <avr/sleep.h>
+#elif defined(ARDUINO_ARCH_ESP32)
+    #include "esp_sleep.h"
+    #include "driver/gpio.h"
+#endif
+
+#if defined(__AVR__)
+
+//idle until the next interrupt, timer 0 wakes the core every ms so the timeout is checked by the caller
+void scd30Sleep(SCD30WakeSource source, uint8_t pin, uint32_t /*timeout*/)
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+
+    noInterrupts();
+    if (source == SCD30_WAKE_READY && digitalRead(pin) == HIGH)
+    {
+        interrupts(); //RDY already went high, do not sleep
+        return;
+    }
+    sleep_enable();
+    interrupts(); //the instruction after sei is always executed, so no interrupt can be lost before sleep_cpu()
+    sleep_cpu();
+    sleep_disable();
+}
+
+#elif defined(ARDUINO_ARCH_SAMD)
+
+//idle until the next interrupt, SysTick wakes the core every ms so the timeout is checked by the caller
+void scd30Sleep(SCD30WakeSource source, uint8_t pin, uint32_t /*timeout*/)
+{
+    if (source == SCD30_WAKE_READY && digitalRead(pin) == HIGH)
+        return;
+
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+}
+
+#elif defined(ARDUINO_ARCH_ESP32)
+
+//light sleep, the bus and the rest of the peripherals keep their state
+void scd30Sleep(SCD30WakeSource source, uint8_t pin, uint32_t timeout)
+{
+    if (source == SCD30_WAKE_READY)
+    {
+        if (digitalRead(pin) == HIGH)
+            return;
+
+        //edges can not wake from light sleep, a high level would fire the interrupt of attachReadyInterrupt()
+        //again and again while RDY is high, so it is off until the edge is set back
+        gpio_intr_disable((gpio_num_t)pin);
+        gpio_wakeup_enable((gpio_num_t)pin, GPIO_INTR_HIGH_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+    }
+
+    esp_sleep_enable_timer_wakeup((uint64_t)timeout * 1000);
+    esp_light_sleep_start();
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+
+    if (source == SCD30_WAKE_READY)
+    {
+        gpio_wakeup_disable((gpio_num_t)pin);
+        gpio_set_intr_type((gpio_num_t)pin, GPIO_INTR_POSEDGE); //give the pin back to attachInterrupt()
+        gpio_intr_enable((gpio_num_t)pin); //an edge while it was off is seen by the caller, RDY is still high
+    }
+}
+
+#else
+
+//no sleep mode known for this core
+void scd30Sleep(SCD30WakeSource source, uint8_t /*pin*/, uint32_t timeout)
+{
+    if (source == SCD30_WAKE_READY)
+        delay(1);
+    else
+        delay(timeout);
+}
+
+#endif
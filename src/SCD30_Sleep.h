@@ -0,0 +1,36 @@
+/*
+Low power helpers for the SCD30, used by SCD30::sleepUntilReady().
+
+The MCU sleeps until RDY of the SCD30 goes high, or until the next sample is due by the measurement interval.
+Without a sleep function set sleepUntilReady() only waits, pass scd30Sleep() to SCD30::setSleepHook() to sleep.
+It uses the deepest mode the core can wake up from in time:
+    AVR - idle, timer 0 wakes the core every ms, for power-down include SCD30_PowerDown.h in the sketch
+          and pass scd30SleepPowerDown() to SCD30::setSleepHook()
+    SAMD - idle, standby would need the EIC to run from a clock that is kept in standby
+    ESP32 - light sleep, RDY wakes the core with a high level, the timer limits the sleep,
+            the pin interrupt is off while the pin waits for the level
+    others - no sleep, just waits
+Or pass your own function to use another mode.
+*/
+
+#ifndef SCD30_Sleep_h
+#define SCD30_Sleep_h
+
+#include <stdint.h>
+
+#define SCD30_WAKE_SLACK 1000 //ms to wait for a sample after a timer wake up, the sensor clock drifts
+
+//what wakes the MCU, see SCD30::setWakeSource()
+enum SCD30WakeSource
+{
+    SCD30_WAKE_READY, //RDY pin, needs attachReadyInterrupt()
+    SCD30_WAKE_TIMER //the measurement interval
+};
+
+//sleeps until pin goes high (SCD30_WAKE_READY) or for at most timeout ms
+//may return early, the caller checks why it woke up and sleeps again if needed
+typedef void (*SCD30SleepHook)(SCD30WakeSource source, uint8_t pin, uint32_t timeout);
+
+void scd30Sleep(SCD30WakeSource source, uint8_t pin, uint32_t timeout); //sleeps in the mode of the core, see above
+
+#endif
@@ -0,0 +1,158 @@
+/*
+Streaming statistics of SCD30 samples.
+See SCD30_Stats.h for details.
+*/
+
+#include "SCD30_Stats.h"
+
+//adds a value, every running sum is updated with the differences from the current means (Welford),
+//this stays accurate in float also for large values like CO2 with small changes
+void SCD30RunningStats::add(float value, float minutes, float alpha)
+{
+    count++;
+
+    if (count == 1)
+    {
+        mean = value;
+        minimum = value;
+        maximum = value;
+        ewma = value;
+        meanTime = minutes;
+        return;
+    }
+
+    float delta = value - mean;
+    float deltaTime = minutes - meanTime;
+
+    mean += delta / count;
+    meanTime += deltaTime / count;
+
+    m2 += delta * (value - mean);
+    timeM2 += deltaTime * (minutes - meanTime);
+    covariance += delta * (minutes - meanTime);
+
+    if (value < minimum)
+        minimum = value;
+    if (value > maximum)
+        maximum = value;
+
+    ewma += alpha * (value - ewma);
+}
+
+void SCD30RunningStats::reset()
+{
+    *this = SCD30RunningStats();
+}
+
+uint32_t SCD30RunningStats::getCount()
+{
+    return count;
+}
+
+float SCD30RunningStats::getMean()
+{
+    return mean;
+}
+
+float SCD30RunningStats::getVariance()
+{
+    return (count > 1) ? m2 / (count - 1) : 0;
+}
+
+float SCD30RunningStats::getStdDev()
+{
+    return sqrtf(getVariance());
+}
+
+float SCD30RunningStats::getMin()
+{
+    return minimum;
+}
+
+float SCD30RunningStats::getMax()
+{
+    return maximum;
+}
+
+float SCD30RunningStats::getEWMA()
+{
+    return ewma;
+}
+
+float SCD30RunningStats::getSlope()
+{
+    return (timeM2 > 0) ? covariance / timeM2 : 0;
+}
+
+SCD30Stats::SCD30Stats(float alpha) : alpha(alpha)
+{
+    //constructor
+}
+
+//adds a sample, time is taken from the timestamp of the sample
+void SCD30Stats::add(const SCD30Measurement &sample)
+{
+    if (getCount() == 0)
+        start = sample.timestamp;
+
+    last = sample.timestamp;
+    float minutes = (sample.timestamp - start) / 60000.0f;
+
+    quantities[SCD30_QUANTITY_CO2].add(sample.co2, minutes, alpha);
+    quantities[SCD30_QUANTITY_TEMPERATURE].add(sample.temperature, minutes, alpha);
+    quantities[SCD30_QUANTITY_HUMIDITY].add(sample.humidity, minutes, alpha);
+}
+
+void SCD30Stats::reset()
+{
+    for (uint8_t i = 0; i < SCD30_QUANTITY_COUNT; i++)
+        quantities[i].reset();
+
+    start = 0;
+    last = 0;
+}
+
+void SCD30Stats::setAlpha(float alpha)
+{
+    this->alpha = alpha;
+}
+
+float SCD30Stats::getAlpha()
+{
+    return alpha;
+}
+
+uint32_t SCD30Stats::getCount()
+{
+    return quantities[SCD30_QUANTITY_CO2].getCount();
+}
+
+uint32_t SCD30Stats::getStart()
+{
+    return start;
+}
+
+uint32_t SCD30Stats::getDuration()
+{
+    return last - start;
+}
+
+SCD30RunningStats& SCD30Stats::get(SCD30Quantity quantity)
+{
+    return quantities[quantity];
+}
+
+SCD30RunningStats& SCD30Stats::getCO2()
+{
+    return quantities[SCD30_QUANTITY_CO2];
+}
+
+SCD30RunningStats& SCD30Stats::getTemperature()
+{
+    return quantities[SCD30_QUANTITY_TEMPERATURE];
+}
+
+SCD30RunningStats& SCD30Stats::getHumidity()
+{
+    return quantities[SCD30_QUANTITY_HUMIDITY];
+}
@@ -0,0 +1,87 @@
+/*
+Streaming statistics of SCD30 samples, O(1) per sample and no heap allocation.
+
+For every quantity (CO2, temperature, humidity) it keeps
+    mean and variance (Welford's algorithm)
+    min and max
+    exponentially weighted moving average with a configurable alpha
+    slope per minute, least squares fit over all samples since the last reset
+
+Attach it with SCD30::attachStats() and every sample read by the sensor is added.
+For fixed windows (e.g. a 1 minute and a 15 minute aggregate) read the values and call reset() at the end of the window.
+*/
+
+#ifndef SCD30_Stats_h
+#define SCD30_Stats_h
+
+#include "SCD30_I2C_lib.h"
+
+#define SCD30_STATS_DEFAULT_ALPHA 0.1f
+
+enum SCD30Quantity
+{
+    SCD30_QUANTITY_CO2,
+    SCD30_QUANTITY_TEMPERATURE,
+    SCD30_QUANTITY_HUMIDITY,
+    SCD30_QUANTITY_COUNT
+};
+
+//statistics of one quantity
+class SCD30RunningStats
+{
+    public:
+        void add(float value, float minutes, float alpha); //adds a value taken at minutes since the first sample
+        void reset();
+
+        uint32_t getCount(); //gets number of values added
+        float getMean();
+        float getVariance(); //gets sample variance, 0 with less than two values
+        float getStdDev();
+        float getMin();
+        float getMax();
+        float getEWMA();
+        float getSlope(); //gets change per minute, 0 until the values span some time
+
+    private:
+        uint32_t count = 0;
+        float mean = 0;
+        float m2 = 0; //sum of squared differences from the mean
+        float minimum = 0;
+        float maximum = 0;
+        float ewma = 0;
+
+        //running least squares fit of value over time
+        float meanTime = 0;
+        float timeM2 = 0; //sum of squared differences of time from its mean
+        float covariance = 0; //sum of products of time and value differences
+};
+
+class SCD30Stats
+{
+    public:
+        SCD30Stats(float alpha = SCD30_STATS_DEFAULT_ALPHA); //constructor
+
+        void add(const SCD30Measurement &sample); //adds a sample to all quantities
+        void reset(); //starts a new window, alpha is kept
+
+        void setAlpha(float alpha); //sets weight of a new sample in the EWMA, between 0 and 1
+        float getAlpha();
+
+        uint32_t getCount(); //gets number of samples since the last reset
+        uint32_t getStart(); //gets timestamp of the first sample since the last reset
+        uint32_t getDuration(); //gets ms between the first and the last sample
+
+        SCD30RunningStats& get(SCD30Quantity quantity);
+        SCD30RunningStats& getCO2(); //slope in ppm/min
+        SCD30RunningStats& getTemperature(); //slope in degC/min
+        SCD30RunningStats& getHumidity(); //slope in %RH/min
+
+    private:
+        SCD30RunningStats quantities[SCD30_QUANTITY_COUNT];
+        float alpha;
+
+        uint32_t start = 0;
+        uint32_t last = 0;
+};
+
+#endif
@@ -0,0 +1,242 @@
+/*
+Transport layer between the SCD30 driver and the bus.
+See SCD30_Transport.h for details.
+*/
+
+#include "SCD30_Transport.h"
+#include "SCD30_CRC.h"
+
+//returns a short description of the error, e.g. for logging
+const char* scd30ErrorToString(SCD30Error error)
+{
+    switch (error)
+    {
+        case SCD30_OK: return "ok";
+        case SCD30_ERROR_NACK_ADDRESS: return "address not acknowledged";
+        case SCD30_ERROR_NACK_DATA: return "data not acknowledged";
+        case SCD30_ERROR_SHORT_READ: return "short read";
+        case SCD30_ERROR_CRC: return "CRC mismatch";
+        case SCD30_ERROR_TIMEOUT: return "timeout";
+        case SCD30_ERROR_NOT_READY: return "not ready";
+        case SCD30_ERROR_BUS: return "bus error";
+        default: return "unknown";
+    }
+}
+
+//maps the result of Wire.endTransmission() to an error
+static SCD30Error endTransmissionError(uint8_t result)
+{
+    switch (result)
+    {
+        case 0: return SCD30_OK;
+        case 2: return SCD30_ERROR_NACK_ADDRESS;
+        case 3: return SCD30_ERROR_NACK_DATA;
+        case 5: return SCD30_ERROR_TIMEOUT; //only reported by cores that support a Wire timeout
+        default: return SCD30_ERROR_BUS; //data too long for the buffer or other error
+    }
+}
+
+//ends the bus on cores whose TwoWire has end(), the other overload is picked where it does not
+//on ESP32 begin() does nothing on a started bus, so after recover() the pins would stay GPIOs without it
+template <class Bus>
+static auto endBus(Bus &bus, int) -> decltype(bus.end(), void())
+{
+    bus.end();
+}
+
+template <class Bus>
+static void endBus(Bus &, long)
+{
+}
+
+SCD30WireTransport::SCD30WireTransport(TwoWire &wirePort, SCD30Mux *mux, uint8_t muxChannel) : wire(&wirePort), mux(mux), muxChannel(muxChannel)
+{
+    //constructor
+}
+
+void SCD30WireTransport::begin()
+{
+    wire->begin(); //initiate the Wire library and join the I2C bus as a master
+    wire->setClock(clock); //begin() sets the platform default
+}
+
+//sends a command without arguments
+SCD30Error SCD30WireTransport::writeCommand(uint16_t command)
+{
+    if (selectChannel() == false)
+        return SCD30_ERROR_BUS;
+
+    applyTimeout();
+    uint32_t start = micros();
+
+    wire->beginTransmission(SCD30_I2C_ADDRESS);
+    wire->write(command >> 8); //MSB of command
+    wire->write(command & 0x00FF); //LSB of command
+
+    return checkTimeout(endTransmissionError(wire->endTransmission()), start);
+}
+
+//sends a command with an argument
+//we need to calculate CRC on the argument
+SCD30Error SCD30WireTransport::writeCommand(uint16_t command, uint16_t argument)
+{
+    uint8_t data[2];
+    data[0] = argument >> 8; //MSB of argument
+    data[1] = argument & 0x00FF; //LSB of argument
+    uint8_t crc = scd30ComputeCRC8(data, 2); //calculate CRC on argument
+
+    if (selectChannel() == false)
+        return SCD30_ERROR_BUS;
+
+    applyTimeout();
+    uint32_t start = micros();
+
+    wire->beginTransmission(SCD30_I2C_ADDRESS);
+    wire->write(command >> 8); //MSB of command
+    wire->write(command & 0x00FF); //LSB of command
+    wire->write(data[0]); //MSB of argument
+    wire->write(data[1]); //LSB of argument
+    wire->write(crc); //we have to also send the CRC
+
+    return checkTimeout(endTransmissionError(wire->endTransmission()), start);
+}
+
+//reads the response to the last command
+//the multiplexer channel is selected again, another sensor may have switched it since the command was sent
+SCD30Error SCD30WireTransport::read(uint8_t data[], uint8_t length)
+{
+    if (selectChannel() == false)
+        return SCD30_ERROR_BUS;
+
+    applyTimeout();
+    uint32_t start = micros();
+
+    wire->requestFrom((uint8_t)SCD30_I2C_ADDRESS, length);
+
+    if (wire->available() < length)
+    {
+        while (wire->available() > 0)
+            wire->read(); //drop what we got, we do not want to mix values from different reads
+
+#if defined(WIRE_HAS_TIMEOUT)
+        if (wire->getWireTimeoutFlag() == true)
+        {
+            wire->clearWireTimeoutFlag();
+            return SCD30_ERROR_TIMEOUT;
+        }
+#endif
+
+        return checkTimeout(SCD30_ERROR_SHORT_READ, start);
+    }
+
+    if (wire->readBytes(data, length) < length)
+        return SCD30_ERROR_SHORT_READ; //the data is already buffered, so it can only be missing if the core lost it
+
+    return SCD30_OK;
+}
+
+//frees a bus where the sensor holds SDA low, e.g. because it was reset in the middle of sending a byte
+//SCL is clocked up to SCD30_BUS_CLEAR_CLOCKS times until SDA is released, followed by a STOP and a restart of the bus
+//returns false if SDA is still held low
+boolean SCD30WireTransport::recover()
+{
+    pinMode(sdaPin, INPUT_PULLUP);
+    pinMode(sclPin, INPUT_PULLUP);
+
+    for (uint8_t i = 0; i < SCD30_BUS_CLEAR_CLOCKS && digitalRead(sdaPin) == LOW; i++)
+    {
+        //open drain: drive low, release to let the pull-up pull it high
+        pinMode(sclPin, OUTPUT);
+        digitalWrite(sclPin, LOW);
+        delayMicroseconds(5); //100 kHz
+        pinMode(sclPin, INPUT_PULLUP);
+        delayMicroseconds(5);
+    }
+
+    boolean released = (digitalRead(sdaPin) == HIGH);
+
+    //STOP condition: SDA goes high while SCL is high
+    pinMode(sdaPin, OUTPUT);
+    digitalWrite(sdaPin, LOW);
+    delayMicroseconds(5);
+    pinMode(sdaPin, INPUT_PULLUP);
+    delayMicroseconds(5);
+
+    endBus(*wire, 0); //begin() has to set the bus up again, not only on the first call
+    wire->begin(); //give the pins back to the I2C peripheral
+    wire->setClock(clock);
+
+    if (mux != NULL)
+        mux->invalidate(); //we do not know if the multiplexer kept its channel
+
+    return released;
+}
+
+//sets the timeout of every transaction in us
+//on AVR cores with WIRE_HAS_TIMEOUT and on ESP32 a stuck transaction is aborted,
+//on other cores the transaction can not be aborted, but a failed one that took longer than the timeout is reported as SCD30_ERROR_TIMEOUT
+void SCD30WireTransport::setTimeout(uint32_t timeout)
+{
+    this->timeout = timeout;
+}
+
+//sets the bus clock, 0 or anything above SCD30_I2C_MAX_CLOCK is limited to SCD30_I2C_MAX_CLOCK
+//lower clocks help with long cables, the clock applies to everything else on the same bus as well
+void SCD30WireTransport::setClock(uint32_t clock)
+{
+    if (clock == 0 || clock > SCD30_I2C_MAX_CLOCK)
+        clock = SCD30_I2C_MAX_CLOCK;
+
+    this->clock = clock;
+    wire->setClock(clock);
+}
+
+uint32_t SCD30WireTransport::getClock()
+{
+    return clock;
+}
+
+//sets the pins recover() uses, by default SDA and SCL of the board
+void SCD30WireTransport::setBusPins(uint8_t sdaPin, uint8_t sclPin)
+{
+    this->sdaPin = sdaPin;
+    this->sclPin = sclPin;
+}
+
+//the timeout is set before every transaction, so sensors on the same bus can use different timeouts
+void SCD30WireTransport::applyTimeout()
+{
+    if (timeout == 0)
+        return;
+
+#if defined(WIRE_HAS_TIMEOUT)
+    wire->setWireTimeout(timeout, true); //reset the peripheral on a timeout
+#elif defined(ESP32)
+    wire->setTimeOut((timeout + 999) / 1000); //ms
+#endif
+}
+
+//a failed transaction that took longer than the timeout is reported as a timeout
+//used on cores that can not abort a transaction, a slow transaction that succeeded is still a success
+SCD30Error SCD30WireTransport::checkTimeout(SCD30Error error, uint32_t start)
+{
+    if (error != SCD30_OK && timeout != 0 && (uint32_t)(micros() - start) > timeout)
+        return SCD30_ERROR_TIMEOUT;
+
+    return error;
+}
+
+TwoWire& SCD30WireTransport::getWire()
+{
+    return *wire;
+}
+
+//selects the multiplexer channel of the sensor before a transaction
+//the multiplexer is only written when the channel changes
+boolean SCD30WireTransport::selectChannel()
+{
+    if (mux == NULL)
+        return true; //sensor is directly on the bus
+
+    return mux->select(muxChannel);
+}
@@ -0,0 +1,112 @@
+/*
+Transport layer between the SCD30 driver and the bus.
+
+The driver only needs three operations: write a command, write a command with an argument
+(the transport adds the CRC) and read a number of bytes. SCD30WireTransport does this over a TwoWire bus,
+optionally behind an I2C multiplexer. Other implementations, like SCD30MockTransport,
+can be passed to the SCD30 constructor to run the driver without a sensor.
+*/
+
+#ifndef SCD30_Transport_h
+#define SCD30_Transport_h
+
+#if (ARDUINO >= 100)
+    #include "Arduino.h"
+#else
+    #include "WProgram.h"
+#endif
+
+#include <Wire.h>
+
+#include "SCD30_Mux.h"
+
+#define SCD30_I2C_ADDRESS 0x61 //default SCD30 I2C address
+
+#define SCD30_READ_DELAY_US 3000 //minimum time between writing a command and reading its response
+
+#define SCD30_I2C_MAX_CLOCK 100000 //Hz, the SCD30 supports standard mode only, see 1.1 in document
+
+//SCL clocks one sample holds the bus: ready check (write 3 bytes, read 4) and read measurement (write 3 bytes, read 19),
+//9 clocks per byte and about 2 for START and STOP of each of the 4 transactions
+//the bus is free during the read delays in between, clock stretching by the sensor comes on top
+#define SCD30_SAMPLE_BUS_CLOCKS ((3 + 4 + 3 + 19) * 9 + 4 * 2)
+
+#define SCD30_BUS_CLEAR_CLOCKS 9 //SCL pulses sent by recover(), enough for the sensor to finish any byte it is sending
+
+//pins used to free a stuck bus, most cores name them SDA and SCL
+#ifndef SCD30_SDA_PIN
+    #define SCD30_SDA_PIN SDA
+#endif
+#ifndef SCD30_SCL_PIN
+    #define SCD30_SCL_PIN SCL
+#endif
+
+//result of a transaction
+enum SCD30Error
+{
+    SCD30_OK = 0,
+    SCD30_ERROR_NACK_ADDRESS, //sensor did not ACK its address, it is not there or busy
+    SCD30_ERROR_NACK_DATA, //sensor did not ACK a command or argument byte
+    SCD30_ERROR_SHORT_READ, //fewer bytes received than requested
+    SCD30_ERROR_CRC, //received data does not match its CRC
+    SCD30_ERROR_TIMEOUT, //bus transaction timed out
+    SCD30_ERROR_NOT_READY, //no new sample available
+    SCD30_ERROR_BUS, //multiplexer could not be switched or other bus error
+    SCD30_ERROR_COUNT //number of results, not an error
+};
+
+const char* scd30ErrorToString(SCD30Error error); //gets a short description of the error
+
+class SCD30Transport
+{
+    public:
+        virtual void begin() {} //prepares the bus
+
+        virtual SCD30Error writeCommand(uint16_t command) = 0; //sends a command without argument
+        virtual SCD30Error writeCommand(uint16_t command, uint16_t argument) = 0; //sends a command with an argument and its CRC
+        virtual SCD30Error read(uint8_t data[], uint8_t length) = 0; //reads length bytes, the response to the last command
+
+        virtual uint32_t getReadDelay() { return SCD30_READ_DELAY_US; } //time the sensor needs between a command and the read, in us
+        virtual void setClock(uint32_t /*clock*/) {} //sets the bus clock in Hz
+        virtual uint32_t getClock() { return SCD30_I2C_MAX_CLOCK; } //gets the bus clock in Hz
+
+        virtual boolean recover() { return false; } //tries to free a stuck bus, returns false if the transport can not do that
+};
+
+class SCD30WireTransport : public SCD30Transport
+{
+    public:
+        SCD30WireTransport(TwoWire &wirePort = Wire, SCD30Mux *mux = NULL, uint8_t muxChannel = 0); //constructor
+
+        void begin();
+
+        SCD30Error writeCommand(uint16_t command);
+        SCD30Error writeCommand(uint16_t command, uint16_t argument);
+        SCD30Error read(uint8_t data[], uint8_t length);
+
+        boolean recover(); //clocks SCL until the sensor releases SDA and restarts the bus
+
+        void setClock(uint32_t clock); //sets the bus clock in Hz, at most SCD30_I2C_MAX_CLOCK
+        uint32_t getClock();
+
+        void setTimeout(uint32_t timeout); //sets the timeout of every transaction in us, 0 leaves the platform default
+        void setBusPins(uint8_t sdaPin, uint8_t sclPin); //sets the pins used by recover()
+
+        TwoWire& getWire(); //gets the bus
+
+    private:
+        boolean selectChannel(); //selects the multiplexer channel of the sensor, if there is one
+        void applyTimeout(); //sets the timeout of the bus before a transaction
+        SCD30Error checkTimeout(SCD30Error error, uint32_t start); //reports a timeout on cores that can not abort a transaction
+
+        TwoWire *wire;
+        SCD30Mux *mux;
+        uint8_t muxChannel;
+
+        uint32_t clock = SCD30_I2C_MAX_CLOCK; //Hz
+        uint32_t timeout = 0; //us, 0 leaves the platform default
+        uint8_t sdaPin = SCD30_SDA_PIN;
+        uint8_t sclPin = SCD30_SCL_PIN;
+};
+
+#endif